@@ -0,0 +1,152 @@
+//checks FlowField against a plain breadth first search on random maps. Following the stored steps
+//from every tile in range must reach the target in no more steps than the search found, without
+//entering a blocked tile or cutting a corner, and tiles out of range must have no direction.
+//Exits with failure on any mismatch
+#include <glm/glm.hpp>
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <random>
+#include <algorithm>
+
+#include "flowField.h"
+
+const unsigned int MAPS = 20;
+const unsigned int TARGETS_PER_MAP = 30;
+const unsigned int MAP_WIDTH = 100;
+const unsigned int MAP_HEIGHT = 120;
+const glm::vec2 TILE_SIZE = glm::vec2(16, 20);
+
+static int sign(float v)
+{
+	return v > 0 ? 1 : (v < 0 ? -1 : 0);
+}
+
+int main()
+{
+	std::mt19937 gen(1);
+	std::uniform_int_distribution<int> chance(0, 99);
+	std::uniform_int_distribution<int> tileX(0, MAP_WIDTH - 1);
+	std::uniform_int_distribution<int> tileY(0, MAP_HEIGHT - 1);
+	std::uniform_real_distribution<float> within(0.1f, 0.9f);
+	std::uniform_int_distribution<int> nudge(-3, 3);
+
+	unsigned int checked = 0, tooLong = 0, enteredBlocked = 0, cutCorner = 0, noDirection = 0, outOfRange = 0;
+	for(unsigned int m = 0; m < MAPS; m++)
+	{
+		std::vector<bool> solid(MAP_WIDTH * MAP_HEIGHT), gap(MAP_WIDTH * MAP_HEIGHT);
+		for(unsigned int i = 0; i < solid.size(); i++)
+		{
+			int roll = chance(gen);
+			solid[i] = roll < 20;
+			gap[i] = roll >= 20 && roll < 25;
+		}
+		//every other map is offset like a streamed map's window
+		int originX = m % 2 ? -7 : 0;
+		int originY = m % 2 ? 11 : 0;
+		TileOccupancy occupancy(MAP_WIDTH, MAP_HEIGHT, TILE_SIZE, solid, gap, originX, originY);
+		FlowField field(occupancy);
+		auto blocked = [&](int x, int y) {
+			return x < 0 || y < 0 || x >= (int)MAP_WIDTH || y >= (int)MAP_HEIGHT
+				|| solid[y * MAP_WIDTH + x] || gap[y * MAP_WIDTH + x];
+		};
+		auto centre = [&](int x, int y) {
+			return glm::vec2((x + originX + 0.5f) * TILE_SIZE.x, (y + originY + 0.5f) * TILE_SIZE.y);
+		};
+
+		int tx = tileX(gen), ty = tileY(gen);
+		for(unsigned int t = 0; t < TARGETS_PER_MAP; t++)
+		{
+			//mostly small moves so the field clears what the last search reached, sometimes a jump
+			if(t % 5 == 0)
+			{
+				tx = tileX(gen);
+				ty = tileY(gen);
+			}
+			else
+			{
+				tx = std::min(std::max(tx + nudge(gen), 0), (int)MAP_WIDTH - 1);
+				ty = std::min(std::max(ty + nudge(gen), 0), (int)MAP_HEIGHT - 1);
+			}
+			//the player stands on open tiles
+			if(blocked(tx, ty))
+			{
+				t--;
+				continue;
+			}
+			field.Target(glm::vec2((tx + originX + within(gen)) * TILE_SIZE.x, (ty + originY + within(gen)) * TILE_SIZE.y));
+
+			std::vector<int> steps(MAP_WIDTH * MAP_HEIGHT, -1);
+			std::deque<int> queue;
+			steps[ty * MAP_WIDTH + tx] = 0;
+			queue.push_back(ty * MAP_WIDTH + tx);
+			while(!queue.empty())
+			{
+				int tile = queue.front();
+				queue.pop_front();
+				if(steps[tile] >= (int)FLOW_FIELD_RADIUS)
+					continue;
+				int x = tile % MAP_WIDTH, y = tile / MAP_WIDTH;
+				const int dx[4] = { 1, -1, 0, 0 }, dy[4] = { 0, 0, 1, -1 };
+				for(int d = 0; d < 4; d++)
+				{
+					int nx = x + dx[d], ny = y + dy[d];
+					if(blocked(nx, ny) || steps[ny * MAP_WIDTH + nx] != -1)
+						continue;
+					steps[ny * MAP_WIDTH + nx] = steps[tile] + 1;
+					queue.push_back(ny * MAP_WIDTH + nx);
+				}
+			}
+
+			for(int y = 0; y < (int)MAP_HEIGHT; y++)
+				for(int x = 0; x < (int)MAP_WIDTH; x++)
+				{
+					if(x == tx && y == ty)
+						continue;
+					int expected = steps[y * MAP_WIDTH + x];
+					glm::vec2 dir = field.Sample(centre(x, y));
+					if(expected == -1)
+					{
+						if(dir != glm::vec2(0))
+							outOfRange++;
+						continue;
+					}
+					checked++;
+					int cx = x, cy = y, walked = 0;
+					while(!(cx == tx && cy == ty) && walked <= expected)
+					{
+						dir = field.Sample(centre(cx, cy));
+						int sx = sign(dir.x), sy = sign(dir.y);
+						if(sx == 0 && sy == 0)
+						{
+							noDirection++;
+							break;
+						}
+						if(sx != 0 && sy != 0 && (blocked(cx + sx, cy) || blocked(cx, cy + sy)))
+							cutCorner++;
+						cx += sx;
+						cy += sy;
+						walked++;
+						if(blocked(cx, cy))
+						{
+							enteredBlocked++;
+							break;
+						}
+					}
+					if(walked > expected)
+						tooLong++;
+				}
+		}
+	}
+
+	std::cout << MAPS << " random " << MAP_WIDTH << "x" << MAP_HEIGHT << " maps, " << TARGETS_PER_MAP
+		<< " targets each, " << checked << " in range tiles followed\n"
+		<< "  longer than the search:     " << tooLong << "\n"
+		<< "  entered a blocked tile:     " << enteredBlocked << "\n"
+		<< "  cut a corner:               " << cutCorner << "\n"
+		<< "  stopped without a step:     " << noDirection << "\n"
+		<< "  direction when out of range: " << outOfRange << std::endl;
+	bool ok = tooLong == 0 && enteredBlocked == 0 && cutCorner == 0 && noDirection == 0 && outOfRange == 0;
+	std::cout << (ok ? "passed" : "FAILED") << std::endl;
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
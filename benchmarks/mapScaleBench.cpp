@@ -0,0 +1,152 @@
+//times loading and using maps of different sizes: parsing the tmx, building the Map from the tmx (finite maps only),
+//compiling it and building it from the compiled map, building the collider grid, culling for random camera spots
+//and collision queries. The compiled maps it writes are left beside the tmx.
+//Infinite maps also time moving their active area, and their queries stay inside it.
+//Built headless, run from the resources folder with maps from tools/mapGenerator
+#include <glm/glm.hpp>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <stdexcept>
+
+#include "renderer.h"
+#include "tiled.h"
+#include "map.h"
+#include "spatialGrid.h"
+
+const unsigned int CULL_FRAMES = 1000;
+const unsigned int COLLIDE_QUERIES = 100000;
+const unsigned int SIGHT_QUERIES = 10000;
+const unsigned int ACTIVE_MOVES = 100;
+const glm::vec2 PLAYER_SIZE = glm::vec2(20, 30);
+const float MAX_MOVE = 8.0f;
+
+static double since(std::chrono::high_resolution_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void bench(std::string file, Render &render)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	tiled::Map parsed(file);
+	double parseMs = since(start);
+
+	//infinite maps can't be built without their compiled map, so only finite ones time building from the tmx
+	std::remove(Map::CompiledPath(file).c_str());
+	double mapMs = -1;
+	if(!parsed.infinite)
+	{
+		start = std::chrono::high_resolution_clock::now();
+		Map parsedMap(file, render);
+		mapMs = since(start);
+	}
+
+	start = std::chrono::high_resolution_clock::now();
+	if(!Map::Compile(file))
+		throw std::runtime_error("couldn't write the compiled map for " + file);
+	double compileMs = since(start);
+
+	start = std::chrono::high_resolution_clock::now();
+	Map map(file, render);
+	double compiledMs = since(start);
+
+	glm::vec4 mapArea = map.getMapRect();
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<float> mapX(mapArea.x, mapArea.x + mapArea.z);
+	std::uniform_real_distribution<float> mapY(mapArea.y, mapArea.y + mapArea.w);
+	//jumps far enough that every move changes the active chunks, then back to the spawn for the queries
+	double activeMs = 0;
+	if(map.Streamed())
+	{
+		start = std::chrono::high_resolution_clock::now();
+		for(unsigned int i = 0; i < ACTIVE_MOVES; i++)
+			map.UpdateActive(glm::vec4(mapX(gen), mapY(gen), settings::TARGET_WIDTH, settings::TARGET_HEIGHT));
+		activeMs = since(start);
+		map.UpdateActive(glm::vec4(map.getPlayerSpawn().x, map.getPlayerSpawn().y, 0, 0));
+	}
+
+	//the same grids LoadMap builds
+	start = std::chrono::high_resolution_clock::now();
+	std::vector<glm::vec4> gapColliders = map.getGapColliders();
+	std::vector<glm::vec4> mapColliders = map.getMapColliders();
+	gapColliders.insert(gapColliders.end(), mapColliders.begin(), mapColliders.end());
+	gh::SpatialGrid colliders(map.getActiveRect(), gh::SPATIAL_GRID_CELL_SIZE, gapColliders);
+	double gridMs = since(start);
+
+	glm::vec4 area = map.getActiveRect();
+	std::uniform_real_distribution<float> x(area.x, area.x + area.z);
+	std::uniform_real_distribution<float> y(area.y, area.y + area.w);
+	std::uniform_real_distribution<float> move(-MAX_MOVE, MAX_MOVE);
+
+	start = std::chrono::high_resolution_clock::now();
+	for(unsigned int i = 0; i < CULL_FRAMES; i++)
+	{
+		map.Update(glm::vec4(mapX(gen), mapY(gen), settings::TARGET_WIDTH, settings::TARGET_HEIGHT));
+		map.Draw(render);
+	}
+	double cullMs = since(start);
+
+	unsigned int hits = 0;
+	start = std::chrono::high_resolution_clock::now();
+	for(unsigned int i = 0; i < COLLIDE_QUERIES; i++)
+	{
+		glm::vec4 rect = glm::vec4(x(gen), y(gen), PLAYER_SIZE.x, PLAYER_SIZE.y);
+		if(colliders.MoveAndSlide(rect, glm::vec2(move(gen), move(gen))))
+			hits++;
+	}
+	double collideMs = since(start);
+
+	unsigned int visible = 0;
+	const TileOccupancy &occupancy = map.getOccupancy();
+	start = std::chrono::high_resolution_clock::now();
+	for(unsigned int i = 0; i < SIGHT_QUERIES; i++)
+	{
+		glm::vec2 from = glm::vec2(x(gen), y(gen));
+		glm::vec2 to = from + glm::vec2(move(gen), move(gen)) * 50.0f;
+		if(occupancy.LineOfSight(from, to))
+			visible++;
+	}
+	double sightMs = since(start);
+
+	std::cout << file << ": " << parsed.width << "x" << parsed.height << " tiles, " << parsed.layers.size() << " layers, "
+		<< mapColliders.size() << " colliders, " << gapColliders.size() - mapColliders.size() << " gaps"
+		<< (map.Streamed() ? " active, streamed\n" : "\n")
+		<< "  parse:         " << parseMs << " ms\n";
+	if(mapMs >= 0)
+		std::cout << "  build map:     " << mapMs << " ms (includes parsing and baking chunks)\n";
+	std::cout
+		<< "  compile:       " << compileMs << " ms (parses and writes the compiled map)\n"
+		<< "  compiled map:  " << compiledMs << " ms (includes baking chunks)\n"
+		<< "  collider grid: " << gridMs << " ms\n";
+	if(map.Streamed())
+		std::cout << "  active area:   " << activeMs * 1000.0 / ACTIVE_MOVES << " us/move\n";
+	std::cout
+		<< "  cull and draw: " << cullMs * 1000.0 / CULL_FRAMES << " us/frame\n"
+		<< "  move and slide:" << collideMs * 1000000.0 / COLLIDE_QUERIES << " ns/query, " << hits << " hits\n"
+		<< "  line of sight: " << sightMs * 1000000.0 / SIGHT_QUERIES << " ns/query, " << visible << " clear" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	if(argc < 2)
+	{
+		std::cerr << "usage: " << argv[0] << " <map.tmx>..." << std::endl;
+		return EXIT_FAILURE;
+	}
+	try
+	{
+		Render render(glm::vec2(settings::TARGET_WIDTH, settings::TARGET_HEIGHT));
+		for(int i = 1; i < argc; i++)
+			bench(argv[i], render);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,13 @@
+#!/bin/sh
+# generates maps at each size, finite and infinite, and times them against the shipped maps.
+# usage: mapScaling.sh <build folder> [output folder], run from the resources folder
+BUILD=${1:?"usage: mapScaling.sh <build folder> [output folder]"}
+OUT=${2:-/tmp}
+MAPS="maps/forgottenLab.tmx maps/rememberedLab.tmx"
+for SIZE in 1000 4000
+do
+	"$BUILD/MapGenerator" --size ${SIZE}x${SIZE} --objects $((SIZE * 10)) --out "$OUT/generated$SIZE.tmx" || exit 1
+	"$BUILD/MapGenerator" --size ${SIZE}x${SIZE} --objects $((SIZE * 10)) --infinite 16 --out "$OUT/infinite$SIZE.tmx" || exit 1
+	MAPS="$MAPS $OUT/generated$SIZE.tmx $OUT/infinite$SIZE.tmx"
+done
+"$BUILD/MapScaleBench" $MAPS
@@ -0,0 +1,11 @@
+#!/bin/sh
+# runs the headless stress scenario at each entity count and prints the per system times.
+# usage: stressScaling.sh <path to Headless> [ticks] [map], run from the resources folder
+HEADLESS=${1:?"usage: stressScaling.sh <path to Headless> [ticks] [map]"}
+TICKS=${2:-600}
+MAP=${3:-forgotten}
+for COUNT in 10 100 1000 10000
+do
+	echo "== $COUNT entities"
+	"$HEADLESS" --ticks "$TICKS" --stress "$COUNT" --map "$MAP" || exit 1
+done
@@ -0,0 +1,130 @@
+//checks the swept moves against every wall by brute force: the grid finds the same first hit,
+//movers never end inside a wall, movers starting inside one are pushed out or stay put,
+//long moves don't tunnel through thin walls, and a move the wall tiles say is clear touches no wall.
+//Exits with failure on any mismatch
+#include <glm/glm.hpp>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cmath>
+
+#include "gamehelper.h"
+#include "spatialGrid.h"
+#include "tileOccupancy.h"
+
+const unsigned int WALLS = 400;
+const unsigned int MOVES = 200000;
+const float MAX_MOVE = 200.0f;
+const glm::vec2 AREA = glm::vec2(3200, 3840);
+const glm::vec2 MOVER_SIZE = glm::vec2(20, 30);
+
+static bool insideAny(const std::vector<glm::vec4> &walls, glm::vec4 rect)
+{
+	for(const auto &wall: walls)
+		if(gh::colliding(wall, rect))
+			return true;
+	return false;
+}
+
+int main()
+{
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<float> x(0, AREA.x);
+	std::uniform_real_distribution<float> y(0, AREA.y);
+	std::uniform_real_distribution<float> size(2, 200);
+	std::uniform_real_distribution<float> move(-MAX_MOVE, MAX_MOVE);
+	std::vector<glm::vec4> walls(WALLS);
+	for(auto &wall: walls)
+		wall = glm::vec4(x(gen), y(gen), size(gen), size(gen));
+	gh::SpatialGrid grid(glm::vec4(0, 0, AREA.x, AREA.y), gh::SPATIAL_GRID_CELL_SIZE, walls);
+	//half the walls as gaps, so both bit sets are tested
+	std::vector<glm::vec4> solidWalls(walls.begin(), walls.begin() + WALLS / 2);
+	std::vector<glm::vec4> gapWalls(walls.begin() + WALLS / 2, walls.end());
+	TileOccupancy wallTiles(glm::vec4(0, 0, AREA.x, AREA.y), glm::vec2(32, 32), solidWalls, gapWalls);
+
+	unsigned int firstHitWrong = 0, endedInside = 0, startedInside = 0, stuck = 0, movedWhileStuck = 0;
+	unsigned int clearOfTiles = 0, clearButTouching = 0;
+	for(unsigned int i = 0; i < MOVES; i++)
+	{
+		glm::vec4 rect = glm::vec4(x(gen), y(gen), MOVER_SIZE.x, MOVER_SIZE.y);
+		glm::vec2 delta = glm::vec2(move(gen), move(gen));
+		bool inside = insideAny(walls, rect);
+
+		if(!inside)
+		{
+			float bruteTime = 1;
+			bool bruteFound = false;
+			for(const auto &wall: walls)
+			{
+				float time;
+				glm::vec2 normal;
+				if(gh::sweep(rect, delta, wall, time, normal) && (!bruteFound || time < bruteTime))
+				{
+					bruteFound = true;
+					bruteTime = time;
+				}
+			}
+			gh::SweepHit hit;
+			bool found = grid.Sweep(rect, delta, hit);
+			if(found != bruteFound || (found && hit.time != bruteTime))
+				firstHitWrong++;
+		}
+		else
+			startedInside++;
+
+		glm::vec4 swept = gh::sweptRect(rect, delta);
+		if(wallTiles.Holds(swept) && !wallTiles.SolidIn(swept) && !wallTiles.GapIn(swept))
+		{
+			clearOfTiles++;
+			if(insideAny(walls, swept))
+				clearButTouching++;
+		}
+
+		glm::vec4 start = rect;
+		glm::vec4 slid = rect;
+		grid.MoveAndSlide(slid, delta);
+		glm::vec4 reflected = rect;
+		glm::vec2 velocity = delta;
+		grid.MoveAndReflect(reflected, delta, velocity);
+		for(const auto &moved: { slid, reflected })
+		{
+			if(!insideAny(walls, moved))
+				continue;
+			//only allowed when it couldn't be pushed out, and then it mustn't move
+			if(!inside)
+				endedInside++;
+			else if(moved != start)
+				movedWhileStuck++;
+			else
+				stuck++;
+		}
+	}
+
+	//a thin wall across the path of moves far longer than it is wide
+	std::vector<glm::vec4> thin = { glm::vec4(500, 0, 2, 1000) };
+	gh::SpatialGrid thinGrid(glm::vec4(0, 0, 1000, 1000), gh::SPATIAL_GRID_CELL_SIZE, thin);
+	unsigned int tunnelled = 0;
+	for(unsigned int i = 0; i < 1000; i++)
+	{
+		glm::vec4 rect = glm::vec4(300 + i % 150, 100 + i % 700, MOVER_SIZE.x, MOVER_SIZE.y);
+		glm::vec2 velocity = glm::vec2(400, (float)(i % 7) - 3);
+		thinGrid.MoveAndSlide(rect, velocity);
+		if(rect.x + rect.z > 500)
+			tunnelled++;
+		rect = glm::vec4(300 + i % 150, 100 + i % 700, MOVER_SIZE.x, MOVER_SIZE.y);
+		thinGrid.MoveAndReflect(rect, velocity, velocity);
+		if(rect.x + rect.z > 500)
+			tunnelled++;
+	}
+
+	std::cout << MOVES << " moves against " << WALLS << " walls, " << startedInside << " started inside a wall\n"
+		<< "  first hit differs from brute force: " << firstHitWrong << "\n"
+		<< "  ended inside a wall:                " << endedInside << "\n"
+		<< "  stuck inside and left in place:     " << stuck << "\n"
+		<< "  moved while stuck inside:           " << movedWhileStuck << "\n"
+		<< "  tunnelled through a thin wall:      " << tunnelled << "\n"
+		<< "  clear of wall tiles but touching:   " << clearButTouching << " of " << clearOfTiles << std::endl;
+	bool ok = firstHitWrong == 0 && endedInside == 0 && movedWhileStuck == 0 && tunnelled == 0 && clearButTouching == 0;
+	std::cout << (ok ? "passed" : "FAILED") << std::endl;
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,98 @@
+//times bullet vs bullet pair finding, every pair against the sweep and prune broad phase
+#include <glm/glm.hpp>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+
+#include "gamehelper.h"
+#include "sweepPrune.h"
+
+const int TICKS = 60;
+const float FRAME_MS = 16.0f;
+const float BULLET_SPEED = 0.1f;
+const float BULLET_SIZE = 8.0f;
+//forgotten lab is 100x120 tiles of 32 px
+const glm::vec2 AREA = glm::vec2(3200, 3840);
+
+struct BenchBullet
+{
+	glm::vec4 rect;
+	glm::vec2 velocity;
+};
+
+std::vector<BenchBullet> makeBullets(unsigned int count)
+{
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<float> x(0, AREA.x);
+	std::uniform_real_distribution<float> y(0, AREA.y);
+	std::uniform_real_distribution<float> dir(-1, 1);
+	std::vector<BenchBullet> bullets(count);
+	for(auto &b: bullets)
+	{
+		b.rect = glm::vec4(x(gen), y(gen), BULLET_SIZE, BULLET_SIZE);
+		b.velocity = glm::normalize(glm::vec2(dir(gen), dir(gen)) + glm::vec2(0.001f)) * BULLET_SPEED;
+	}
+	return bullets;
+}
+
+void step(std::vector<BenchBullet> &bullets)
+{
+	for(auto &b: bullets)
+	{
+		b.rect.x += b.velocity.x * FRAME_MS;
+		b.rect.y += b.velocity.y * FRAME_MS;
+		if(b.rect.x < 0 || b.rect.x > AREA.x)
+			b.velocity.x *= -1;
+		if(b.rect.y < 0 || b.rect.y > AREA.y)
+			b.velocity.y *= -1;
+	}
+}
+
+void bench(unsigned int count)
+{
+	std::vector<BenchBullet> bullets = makeBullets(count);
+	size_t brutePairs = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for(int t = 0; t < TICKS; t++)
+	{
+		step(bullets);
+		for(unsigned int i = 0; i < bullets.size(); i++)
+			for(unsigned int j = i + 1; j < bullets.size(); j++)
+				if(gh::colliding(bullets[i].rect, bullets[j].rect))
+					brutePairs++;
+	}
+	double bruteMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	bullets = makeBullets(count);
+	gh::SweepAndPrune broadPhase;
+	std::vector<glm::vec4> rects(count);
+	std::vector<std::pair<unsigned int, unsigned int>> pairs;
+	size_t sweepPairs = 0;
+	start = std::chrono::high_resolution_clock::now();
+	for(int t = 0; t < TICKS; t++)
+	{
+		step(bullets);
+		for(unsigned int i = 0; i < bullets.size(); i++)
+			rects[i] = bullets[i].rect;
+		broadPhase.Update(rects);
+		broadPhase.Pairs(pairs);
+		for(const auto &p: pairs)
+			if(gh::colliding(bullets[p.first].rect, bullets[p.second].rect))
+				sweepPairs++;
+	}
+	double sweepMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	std::cout << count << " bullets, " << TICKS << " ticks\n"
+		<< "  every pair:      " << bruteMs / TICKS << " ms/tick, " << brutePairs << " hits\n"
+		<< "  sweep and prune: " << sweepMs / TICKS << " ms/tick, " << sweepPairs << " hits" << std::endl;
+	if(brutePairs != sweepPairs)
+		std::cout << "  hit counts differ!" << std::endl;
+}
+
+int main()
+{
+	bench(1000);
+	bench(10000);
+	return 0;
+}
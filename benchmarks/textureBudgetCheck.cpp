@@ -0,0 +1,52 @@
+//checks that building the given maps, like the game does before its other assets, leaves the renderer
+//the textures it reserves for them, and that the font and the rest of the reserve still fit.
+//Built headless, run from the resources folder. Exits with failure when the texture budget is exceeded
+#include <glm/glm.hpp>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <stdexcept>
+
+#include "renderer.h"
+#include "map.h"
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> files;
+	for(int i = 1; i < argc; i++)
+		files.push_back(argv[i]);
+	if(files.empty())
+		files = { "maps/forgottenLab.tmx", "maps/rememberedLab.tmx" };
+
+	bool ok = true;
+	try
+	{
+		Render render(glm::vec2(settings::TARGET_WIDTH, settings::TARGET_HEIGHT));
+		std::vector<std::unique_ptr<Map>> maps;
+		for(const auto &file: files)
+		{
+			maps.push_back(std::unique_ptr<Map>(new Map(file, render)));
+			std::cout << file << ": " << render.TexturesLeft() << " textures left" << std::endl;
+		}
+		if(render.TexturesLeft() < MAP_TEXTURE_RESERVE)
+		{
+			std::cout << "  maps left less than the " << MAP_TEXTURE_RESERVE << " textures reserved" << std::endl;
+			ok = false;
+		}
+
+		//everything loaded after the maps: the font, then single pixels up to the reserve
+		unsigned int left = render.TexturesLeft();
+		render.LoadFont("textures/dogicapixel.otf");
+		for(unsigned int loaded = left - render.TexturesLeft(); loaded < MAP_TEXTURE_RESERVE; loaded++)
+			render.LoadTexture(new unsigned char[4](), 1, 1, 4);
+		render.endResourceLoad();
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << "  " << e.what() << std::endl;
+		ok = false;
+	}
+	std::cout << (ok ? "passed" : "FAILED") << std::endl;
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,96 @@
+//checks TriggerIndex's events against testing every trigger each move, over a random walk
+//with the odd teleport and triggers disabled along the way. Exits with failure on any mismatch
+#include <glm/glm.hpp>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "triggers.h"
+
+const unsigned int TRIGGERS = 300;
+const unsigned int MOVES = 200000;
+const glm::vec2 AREA = glm::vec2(3200, 3840);
+const glm::vec2 HITBOX_SIZE = glm::vec2(20, 30);
+const glm::vec2 SPRITE_SIZE = glm::vec2(40, 60);
+
+static bool sameEvents(const std::vector<TriggerHit> &a, const std::vector<TriggerHit> &b)
+{
+	if(a.size() != b.size())
+		return false;
+	for(size_t i = 0; i < a.size(); i++)
+		if(a[i].event != b[i].event || a[i].type != b[i].type || a[i].trigger != b[i].trigger || a[i].data != b[i].data)
+			return false;
+	return true;
+}
+
+int main()
+{
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<float> x(-100, AREA.x + 100);
+	std::uniform_real_distribution<float> y(-100, AREA.y + 100);
+	std::uniform_real_distribution<float> size(5, 400);
+	std::uniform_real_distribution<float> step(-40, 40);
+	std::uniform_int_distribution<int> type(0, (int)TriggerType::Door);
+	std::uniform_int_distribution<int> chance(0, 999);
+
+	std::vector<Trigger> triggers(TRIGGERS);
+	TriggerIndex index;
+	for(unsigned int i = 0; i < TRIGGERS; i++)
+	{
+		triggers[i] = { glm::vec4(x(gen), y(gen), size(gen), size(gen)), (TriggerType)type(gen), i * 3 };
+		index.Add(triggers[i].rect, triggers[i].type, triggers[i].data);
+	}
+	index.Build(glm::vec4(0, 0, AREA.x, AREA.y));
+	std::vector<unsigned char> inside(TRIGGERS, 0), disabled(TRIGGERS, 0);
+
+	glm::vec2 pos = glm::vec2(AREA.x / 2, AREA.y / 2);
+	std::vector<TriggerHit> expected;
+	unsigned int mismatches = 0, events = 0, disables = 0;
+	for(unsigned int i = 0; i < MOVES; i++)
+	{
+		if(chance(gen) < 5)
+			pos = glm::vec2(x(gen), y(gen));
+		else
+			pos += glm::vec2(step(gen), step(gen));
+		pos.x = std::min(std::max(pos.x, -100.0f), AREA.x + 100);
+		pos.y = std::min(std::max(pos.y, -100.0f), AREA.y + 100);
+		glm::vec4 hitbox = glm::vec4(pos.x, pos.y, HITBOX_SIZE.x, HITBOX_SIZE.y);
+		glm::vec4 sprite = glm::vec4(pos.x - (SPRITE_SIZE.x - HITBOX_SIZE.x) / 2, pos.y - (SPRITE_SIZE.y - HITBOX_SIZE.y),
+								SPRITE_SIZE.x, SPRITE_SIZE.y);
+
+		index.Update(hitbox, sprite);
+		expected.clear();
+		for(unsigned int t = 0; t < TRIGGERS; t++)
+		{
+			if(disabled[t])
+				continue;
+			bool touching = gh::colliding(TriggerIndex::OnSprite(triggers[t].type) ? sprite : hitbox, triggers[t].rect);
+			if(touching)
+				expected.push_back({inside[t] ? TriggerEvent::Stay : TriggerEvent::Enter, triggers[t].type, t, triggers[t].data});
+			else if(inside[t])
+				expected.push_back({TriggerEvent::Exit, triggers[t].type, t, triggers[t].data});
+			inside[t] = touching;
+		}
+		if(!sameEvents(index.Events(), expected))
+			mismatches++;
+		events += (unsigned int)expected.size();
+
+		//like a message being shown
+		for(const auto &hit: expected)
+			if(hit.event == TriggerEvent::Enter && chance(gen) < 20)
+			{
+				index.Disable(hit.trigger);
+				disabled[hit.trigger] = 1;
+				inside[hit.trigger] = 0;
+				disables++;
+			}
+	}
+
+	std::cout << MOVES << " moves over " << TRIGGERS << " triggers, " << events << " events, "
+		<< disables << " triggers disabled\n"
+		<< "  updates differing from brute force: " << mismatches << std::endl;
+	bool ok = mismatches == 0;
+	std::cout << (ok ? "passed" : "FAILED") << std::endl;
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -2,7 +2,7 @@
 
 
 
-void Actor::Update(Timer &timer, std::vector<glm::vec4> &colliders)
+void Actor::Update(Timer &timer, gh::SpatialGrid &colliders, const TileOccupancy &walls)
 	{
 		glm::vec2 ogHitboxPos = glm::vec2(hitbox.x, hitbox.y);
 		if(abs(velocity.x) + abs(velocity.y) > max_speed)
@@ -15,32 +15,19 @@ void Actor::Update(Timer &timer, std::vector<glm::vec4> &colliders)
 		{
 			velocity = pushDir;
 		}
-		collided = false;
-
-		float prevX = hitbox.x;
-		hitbox.x += velocity.x * timer.FrameElapsed();
-		for(const auto &rect: colliders)
+		glm::vec2 delta = velocity * (float)timer.FrameElapsed();
+		//no wall tile anywhere along the move, so the grid has nothing to find
+		glm::vec4 swept = gh::sweptRect(hitbox, delta);
+		if(walls.Holds(swept) && !walls.SolidIn(swept) && !walls.GapIn(swept))
 		{
-			if(gh::colliding(rect, hitbox))
-			{
-				collided = true;
-				hitbox.x = prevX;
-				break;
-			}
+			hitbox.x += delta.x;
+			hitbox.y += delta.y;
+			collided = false;
 		}
-		float prevY = hitbox.y;
-		hitbox.y += velocity.y * timer.FrameElapsed();
+		else
+			collided = colliders.MoveAndSlide(hitbox, delta);
 
 		prevAnim = direction;
-		for(const auto &rect: colliders)
-		{
-			if(gh::colliding(rect, hitbox))
-			{
-				collided = true;
-				hitbox.y = prevY;
-				break;
-			}
-		}
 		if(pushTimer > pushDelay)
 		{
 		if(velocity == glm::vec2(0))
@@ -104,7 +91,7 @@ Player::Player(std::vector<Animation> animations, glm::vec2 position, Audio *aud
 	hitbox += hitboxOffset;
 }
 
-void Player::Update(Timer &timer, Input &input, std::vector<glm::vec4> &colliders)
+void Player::Update(Timer &timer, Input &input, gh::SpatialGrid &colliders, const TileOccupancy &walls)
 	{
 		attackingTimer += timer.FrameElapsed();
 		velocity = glm::vec2(0);
@@ -147,7 +134,7 @@ void Player::Update(Timer &timer, Input &input, std::vector<glm::vec4> &collider
 		//	hitbox.x -= 18;
 		}
 
-		Actor::Update(timer, colliders);
+		Actor::Update(timer, colliders, walls);
 
 		if(attackingTimer < attackingDelay)
 		{
@@ -200,7 +187,7 @@ void Player::Update(Timer &timer, Input &input, std::vector<glm::vec4> &collider
 		{
 			if(attackingTimer < attackingDelay)
 			{
-				render.DrawQuad(attackFrame.tex, weaponMat, glm::vec4(1), attackFrame.textureOffset);
+				render.DrawQuad(attackFrame.tex, drawOffset * weaponMat, glm::vec4(1), attackFrame.textureOffset);
 			}
 			Actor::Draw(render, cameraRect);
 		}
@@ -209,20 +196,8 @@ void Player::Update(Timer &timer, Input &input, std::vector<glm::vec4> &collider
 			Actor::Draw(render, cameraRect);
 			if(attackingTimer < attackingDelay)
 			{
-				render.DrawQuad(attackFrame.tex, weaponMat, glm::vec4(1), attackFrame.textureOffset);
+				render.DrawQuad(attackFrame.tex, drawOffset * weaponMat, glm::vec4(1), attackFrame.textureOffset);
 			}
 		}
 		//	render.DrawQuad(Resource::Texture(), vkhelper::getModelMatrix(hitbox, 0), glm::vec4(1), glm::vec4(0, 0, 1, 1));
 	}
-
-void Enemy::Update(Timer &timer, std::vector<glm::vec4> &colliders, glm::vec2 player)
-{
-	if(active)
-	{
-		spriteRect = hitbox;
-		shootTimer += timer.FrameElapsed();
-		if(collided)
-			velocity = -velocity;
-		Actor::Update(timer, colliders);
-	}
-}
@@ -4,8 +4,7 @@
 #include <glm/glm.hpp>
 #include <vector>
 #include <algorithm>
-#include "vulkan-render/texture_loader.h"
-#include "vulkan-render/vkhelper.h"
+#include "renderer.h"
 #include "timer.h"
 
 struct Frame
@@ -1,10 +1,14 @@
 #include "app.h"
 
-App::App()
+App::App(RunOptions options)
 {
+	this->options = options;
 	//set member variables
 	mWindowWidth = settings::TARGET_WIDTH * 2;
 	mWindowHeight = settings::TARGET_HEIGHT * 2;
+#ifdef HEADLESS
+	mRender = new Render(glm::vec2(settings::TARGET_WIDTH, settings::TARGET_HEIGHT));
+#else
 	//init glfw window
 	glfwSetErrorCallback(error_callback);
 	if (!glfwInit())
@@ -36,18 +40,20 @@ App::App()
 		glfwSetWindowAspectRatio(mWindow, settings::TARGET_WIDTH, settings::TARGET_HEIGHT);
 
 	mRender = new Render(mWindow, glm::vec2(settings::TARGET_WIDTH, settings::TARGET_HEIGHT));
+#endif
 	loadAssets();
 
 }
 
 App::~App()
 {
-	if(submitDraw.joinable())
-		submitDraw.join();
+	drawSubmit.Wait();
 	delete mRender;
 	mRender = nullptr;
+#ifndef HEADLESS
 	glfwDestroyWindow(mWindow);
 	glfwTerminate();
+#endif
 }
 
 void App::loadAssets()
@@ -80,9 +86,16 @@ void App::loadAssets()
 		Animation(mRender->LoadTexture("textures/old_door_anim.png"), 300, 32),
 		Animation(mRender->LoadTexture("textures/old_door_anim.png"), 300, 32, false, true) };
 	assets.bullet = mRender->LoadTexture("textures/sprites/bullet.png");
+	bullets = BulletPool(assets.bullet);
+	entities = EntityStore(assets.enemy1Anim, assets.scientist, &audio);
 	msgManager = MessageManager(*mRender, &audio);
 
-	currentMap = assets.forgottenMap;
+	if(options.startMap == assets.remeberedMap.name)
+		currentMap = assets.remeberedMap;
+	else if(options.startMap == assets.forgottenMap.name)
+		currentMap = assets.forgottenMap;
+	else
+		throw std::runtime_error("no map called " + options.startMap);
 	LoadMap(currentMap);
 	messages.clear();
 	messages = currentMap.getMapMessages();
@@ -98,18 +111,23 @@ void App::loadAssets()
 
 void App::run()
 {
-	while (!glfwWindowShouldClose(mWindow))
+	frameTimer.Update();
+	while (!closing)
 	{
+#ifndef HEADLESS
+		if(glfwWindowShouldClose(mWindow))
+			break;
+#endif
 		update();
 		if(mWindowWidth != 0 && mWindowHeight != 0)
 			draw();
 	}
+	systemTimes.Print(tickCount);
 }
 
 void App::resize(int windowWidth, int windowHeight)
 {
-	if(submitDraw.joinable())
-		submitDraw.join();
+	drawSubmit.Wait();
 	mWindowWidth = windowWidth;
 	mWindowHeight = windowHeight;
 	if(mRender != nullptr && mWindowWidth != 0 && mWindowHeight != 0)
@@ -118,7 +136,7 @@ void App::resize(int windowWidth, int windowHeight)
 
 void App::LoadMap(Map &map)
 {
-	bullets.clear();
+	bullets.Clear();
 	music.stop();
 	music = Audio(currentMap.getMusic());
 	music.loop();
@@ -131,11 +149,14 @@ void App::LoadMap(Map &map)
 	{
 		mRender->setLightingProps(0.005f, 0.0001f);
 	}
-	staticColliders.clear();
-	staticColliders = currentMap.getGapColliders();
-	nonGapColliders.clear();
-	nonGapColliders = currentMap.getMapColliders();
-	staticColliders.insert(staticColliders.end(), nonGapColliders.begin(), nonGapColliders.end());
+	if(map.Streamed())
+	{
+		//only the chunks around where the player starts have colliders and spawn anything
+		glm::vec2 start = map.lastCheckpoint != glm::vec4(0) ? glm::vec2(map.lastCheckpoint) : map.getPlayerSpawn();
+		map.ResetActive();
+		map.UpdateActive(glm::vec4(start.x, start.y, 0, 0));
+	}
+	buildMapColliders();
 	cam2D.SetCameraOffset(map.getPlayerSpawn());
 	cam2D.setCameraRects(currentMap.getCameraRects());
 	cam2D.setCameraMapRect(currentMap.getMapRect());
@@ -143,215 +164,75 @@ void App::LoadMap(Map &map)
 		player = Player(assets.playerAnim, currentMap.lastCheckpoint, &audio);
 	else
 		player = Player(assets.playerAnim, currentMap.getPlayerSpawn(), &audio);
-	player.Update(timer, input, staticColliders);
-	enemies.clear();
+	player.Update(timer, input, staticColliders, wallTiles);
+	entities.Clear();
+	if(map.name == "forgotten")
+		entities.SetDoorAnimations(assets.oldDoor);
+	else
+		entities.SetDoorAnimations(assets.newDoor);
 	auto eSpawns = currentMap.getEnemySpawns();
 	for(const auto &e: eSpawns)
 	{
 		if(e.type == EnemyTypes::Basic)
-			enemies.push_back(Enemy(assets.enemy1Anim, e.spawn, &audio));
-		enemies.back().Update(timer, staticColliders, player.getMid());
-		enemies.back().active = false;
+			entities.Spawn(Walker, e.spawn);
 	}
-
 	for(const auto &d: map.doors)
-	{
-		if(map.name == "forgotten")
-			doors.push_back(Door(assets.oldDoor, d, &audio));
-		else
-			doors.push_back(Door(assets.newDoor, d, &audio));
-		//enemies.back().Update(timer, staticColliders, player.getMid());
-		//enemies.back().active = false;
-	}
+		entities.Spawn(Door, d);
 	for(const auto &s: map.scientist)
+		entities.Spawn(Scientist, s);
+	if(options.stressCount > 0)
 	{
-		enemies.push_back(Scientist(assets.scientist, s, &audio));
-		enemies.back().Update(timer, staticColliders, player.getMid());
-		enemies.back().active = false;
+		//the same layout every load, so deaths don't change the workload
+		StressCounts spawned = SpawnStress(StressCounts(options.stressCount), STRESS_SEED, player.getMid(),
+				cam2D.getRooms(), currentMap.getOccupancy(), entities, bullets);
+		if(tickCount == 0)
+			std::cout << "stress scenario on " << map.name << ": " << spawned.walkers << " walkers, "
+				<< spawned.scientists << " scientists, " << spawned.doors << " doors, "
+				<< spawned.bullets << " bullets" << std::endl;
 	}
 }
 
+void App::buildMapColliders()
+{
+	std::vector<glm::vec4> gapColliders = currentMap.getGapColliders();
+	std::vector<glm::vec4> mapColliders = currentMap.getMapColliders();
+	gapColliders.insert(gapColliders.end(), mapColliders.begin(), mapColliders.end());
+	staticColliders = gh::SpatialGrid(currentMap.getActiveRect(), gh::SPATIAL_GRID_CELL_SIZE, gapColliders);
+	nonGapColliders = gh::SpatialGrid(currentMap.getActiveRect(), gh::SPATIAL_GRID_CELL_SIZE, mapColliders);
+	wallTiles = TileOccupancy(currentMap.getActiveRect(), currentMap.getOccupancy().getTileSize(),
+					mapColliders, currentMap.getGapColliders());
+	flowField = FlowField(currentMap.getOccupancy());
+}
+
 void App::update()
 {
 #ifdef TIME_APP_DRAW_UPDATE
 	auto start = std::chrono::high_resolution_clock::now();
 #endif
+#ifdef HEADLESS
+	//nothing to wait for, so every frame is one tick
+	double frameTime = SIM_STEP;
+#else
 	glfwPollEvents();
 
-	if(msgManager.isActive())
+	frameTimer.Update();
+	//a long stall only runs a few ticks instead of falling further behind
+	double frameTime = std::min(frameTimer.FrameElapsed(), MAX_FRAME_TIME);
+#endif
+	//playback swaps in the recorded frame time and input, so the same ticks run with the same input
+	if(options.replay != nullptr && !options.replay->Frame(frameTime, input))
 	{
-		msgManager.Update(timer, input);
+		closing = true;
+		return;
 	}
-	else
+	simAccumulator += frameTime;
+	while(simAccumulator >= SIM_STEP && !closing)
 	{
-		
-		assets.waterDrops.Play(timer);
-		player.Update(timer, input, staticColliders);
-		if(gh::colliding(currentMap.getReactorRoom(), player.rect()))
-		{
-			assets.reactorHiss.Play(timer);
-			if(!inReactor)
-			{
-				assets.reactorHum.loop();
-				assets.reactorHum.setVolume(1.0f);
-				music.pause();
-			}
-			inReactor = true;
-		}
-		else
-		{
-			if(inReactor)
-			{
-				music.play();
-							assets.reactorHum.stop();
-			}
-			inReactor = false;
-		}
-		
-		
-		for(unsigned int i = 0; i < currentMap.checkpoints.size(); i++)
-		{
-			if(gh::colliding(currentMap.checkpoints[i], player.getHitBox()))
-			{
-				currentMap.lastCheckpoint = currentMap.checkpoints[i];
-			}
-		}
-		
-		auto playerMid =  player.getMid();
-		for(unsigned int i = 0; i < enemies.size(); i++)
-		{
-			enemies[i].Update(timer, staticColliders, playerMid);
-			if(!enemies[i].active)
-			{
-				if(gh::colliding(enemies[i].getHitBox(), cam2D.currentRoom))
-				{
-					enemies[i].active = true;
-				}
-			}
-			else
-			{
-				if(gh::colliding(enemies[i].getHitBox(), player.getDamageRect()))
-					enemies[i].Hurt(playerMid);
-				if(gh::colliding(enemies[i].getHitBox(), player.getHitBox()))
-					player.Hurt(enemies[i].getMid());
-
-				for(unsigned int j = 0; j < bullets.size(); j++)
-				{
-					if(bullets[j].Active())
-					{
-						if(gh::colliding(enemies[i].getHitBox(), bullets[j].getRect()))
-						{
-							enemies[i].Hurt(bullets[j].getMid());
-							bullets.erase(bullets.begin() + j--);
-						}
-					}
-				}
-
-				if(currentMap.name == "forgotten" && enemies[i].Shoot())
-				{
-					bullets.push_back(Bullet(
-						assets.bullet, 
-						enemies[i].getMid(),
-						glm::normalize(playerMid - enemies[i].getMid()) * 0.1f));
-				}
-			}
-			if(!enemies[i].Alive())
-				enemies.erase(enemies.begin() + i--);
-		}
-
-		for(auto &d: doors)
-		{
-			d.Update(timer, staticColliders, playerMid);
-		}
-		
-		for(unsigned int i = 0; i < bullets.size(); i++)
-		{
-			bullets[i].Update(timer, nonGapColliders);
-			if(gh::colliding(bullets[i].getRect(), player.getDamageRect()))
-			{
-				bullets[i].Reverse(playerMid, glm::vec4(1));
-				bullets.push_back(bullets[i]);
-				bullets.erase(bullets.begin() + i--);
-				continue;
-			}
-			if(gh::colliding(bullets[i].getRect(), player.getHitBox()))
-			{
-				player.Hurt(bullets[i].getMid());
-				bullets.erase(bullets.begin() + i--);
-				continue;
-			}
-			for(unsigned int j = 0; j < bullets.size(); j++)
-			{
-				if(i == j)
-					continue;
-				if(gh::colliding(bullets[i].getRect(), bullets[j].getRect()))
-				{
-					bullets[i].Reverse(bullets[j].getMid(), glm::vec4(1));
-					bullets[j].Reverse(bullets[i].getMid(), glm::vec4(1));
-				}
-			}
-			if(bullets[i].Dead())
-				bullets.erase(bullets.begin() + i--);
-		}
-
-		if(!player.Alive())
-			LoadMap(currentMap);
-
-		bool messageAdded = false;
-		for(unsigned int i = 0; i < messages.size(); i++)
-			if(gh::colliding(player.getHitBox(), messages[i].rect))
-			{
-				for(const auto &s: messages[i].messages)
-				{
-					msgManager.AddMessage(*mRender, s);
-					messageAdded = true;
-				}
-				messages.erase(messages.begin() + i--);
-			}
-			if(!messageAdded)
-			{
-				for(unsigned int i = 0; i < currentMap.items.size(); i++)
-				{
-					if(gh::colliding(currentMap.items[i], player.getHitBox()))
-					{
-						itemCount++;
-							if(currentMap.lastCheckpoint != glm::vec4(0))
-		player = Player(assets.playerAnim, currentMap.lastCheckpoint, &audio);
-	else
-		player = Player(assets.playerAnim, currentMap.getPlayerSpawn(), &audio);
-
-						for(unsigned int e = 0; e < enemies.size(); e++)
-						{
-							if(enemies[e].active)
-								enemies.erase(enemies.begin() + e--);
-						}
-					}
-				}
-			if(itemCount >= 4 || (currentMap.name != "forgotten"))
-			{
-			if(gh::colliding(player.getHitBox(), currentMap.getReactorTP()))
-			{
-				if(currentMap.name == assets.forgottenMap.name)
-				{
-					assets.backInTime = Audio("audio/music/BackInTime.mp3");
-					assets.backInTime.setVolume(0.7f);
-					assets.backInTime.play();
-					currentMap = assets.remeberedMap;
-					LoadMap(currentMap);
-					messages.clear();
-					messages = currentMap.getMapMessages();
-				}
-				else
-				{
-					glfwSetWindowShouldClose(mWindow, true);
-				}
-			}
-		}
-		}
-		
-		
-
+		simAccumulator -= SIM_STEP;
+		timer.Advance(SIM_STEP);
+		tick();
 	}
+	interpolate((float)(simAccumulator / SIM_STEP));
 
 	std::vector<glm::vec2> lights;
 	glm::vec4 camExpanded = cam2D.getCameraArea();
@@ -363,9 +244,9 @@ void App::update()
 	playerSc.x -= cam2D.getCameraOffset().x;
 	playerSc.y -= cam2D.getCameraOffset().y;
 	lights.push_back(appToScreen(playerSc));
-	for(auto &b: bullets)
+	for(unsigned int i = 0; i < bullets.Count(); i++)
 	{
-		glm::vec2 screenCoords = b.getMid();
+		glm::vec2 screenCoords = bullets.getMid(i);
 		screenCoords.x -= cam2D.getCameraOffset().x;
 		screenCoords.y -= cam2D.getCameraOffset().y;
 		lights.push_back(appToScreen(screenCoords));
@@ -383,7 +264,7 @@ void App::update()
 	}
 	mRender->setLights(lights);
 
-	postUpdate();
+	currentMap.Update(cam2D.getCameraArea());
 #ifdef TIME_APP_DRAW_UPDATE
 	auto stop = std::chrono::high_resolution_clock::now();
 	std::cout 
@@ -393,16 +274,274 @@ void App::update()
 #endif
 }
 
+void App::tick()
+{
+	player.SavePrevious();
+	entities.SavePrevious();
+	bullets.SavePrevious();
+
+	if(msgManager.isActive())
+	{
+		systemTimes.Start(gh::SimSystem::Messages);
+		msgManager.Update(timer, input);
+	}
+	else
+	{
+		systemTimes.Start(gh::SimSystem::Player);
+		assets.waterDrops.Play(timer);
+		player.Update(timer, input, staticColliders, wallTiles);
+		//trigger events stay valid for the whole tick, even if the map is swapped
+		systemTimes.Start(gh::SimSystem::Triggers);
+		currentMap.triggers.Update(player.getHitBox(), player.rect());
+		std::vector<TriggerHit> triggerEvents = currentMap.triggers.Events();
+		for(const auto &e: triggerEvents)
+		{
+			bool inside = e.event != TriggerEvent::Exit;
+			switch(e.type)
+			{
+				case TriggerType::ReactorRoom:
+					if(inside)
+					{
+						assets.reactorHiss.Play(timer);
+						if(!inReactor)
+						{
+							assets.reactorHum.loop();
+							assets.reactorHum.setVolume(1.0f);
+							music.pause();
+						}
+						inReactor = true;
+					}
+					else
+						leaveReactor();
+					break;
+				case TriggerType::Checkpoint:
+					if(inside)
+						currentMap.lastCheckpoint = currentMap.checkpoints[e.data];
+					break;
+				case TriggerType::Door:
+					if(inside)
+						entities.DoorPlayerNear(e.data, player.getMid());
+					else
+						entities.DoorPlayerLeft(e.data);
+					break;
+				default:
+					break;
+			}
+		}
+
+		systemTimes.Start(gh::SimSystem::Enemies);
+		auto playerMid =  player.getMid();
+		//enemies away from the player's room sleep, the rest are checked by their place in the awake list.
+		//enemies activated this tick aren't checked until the next
+		//twice the view around the player, from the simulation rather than the interpolated camera
+		glm::vec4 nearArea = glm::vec4(playerMid.x - settings::TARGET_WIDTH, playerMid.y - settings::TARGET_HEIGHT,
+						settings::TARGET_WIDTH * 2, settings::TARGET_HEIGHT * 2);
+		//a streamed map moves its colliders along with the player, and spawns what is in chunks it reaches
+		if(currentMap.UpdateActive(nearArea))
+		{
+			buildMapColliders();
+			for(const auto &e: currentMap.getEnemySpawns())
+				if(e.type == EnemyTypes::Basic)
+					entities.Spawn(Walker, e.spawn);
+			for(const auto &s: currentMap.scientist)
+				entities.Spawn(Scientist, s);
+		}
+		entities.Wake(cam2D.getRooms(), cam2D.getLastRoom(), nearArea);
+		const std::vector<unsigned int> &awake = entities.AwakeEnemies();
+		unsigned int enemyCount = awake.size();
+		std::vector<bool> enemyChecked(enemyCount, false);
+		for(unsigned int a = 0; a < enemyCount; a++)
+			enemyChecked[a] = entities.EnemyActive(awake[a]);
+		flowField.Target(playerMid);
+		entities.Update(timer, staticColliders, wallTiles, cam2D.currentRoom, flowField);
+		systemTimes.Start(gh::SimSystem::EnemyHits);
+		for(unsigned int a = 0; a < enemyCount; a++)
+		{
+			if(!enemyChecked[a])
+				continue;
+			unsigned int i = awake[a];
+			if(gh::colliding(entities.EnemyHitBox(i), player.getDamageRect()))
+				entities.HurtEnemy(i, playerMid);
+			if(gh::colliding(entities.EnemyHitBox(i), player.getHitBox()))
+				player.Hurt(entities.EnemyMid(i));
+		}
+
+		//bullets then enemies in one broad phase, in enemy then bullet order like testing every pair
+		unsigned int bulletCount = bullets.Count();
+		std::vector<glm::vec4> broadRects(bulletCount + enemyCount);
+		for(unsigned int i = 0; i < bulletCount; i++)
+			broadRects[i] = bullets.getRect(i);
+		for(unsigned int i = 0; i < enemyCount; i++)
+			broadRects[bulletCount + i] = entities.EnemyHitBox(awake[i]);
+		enemyBroadPhase.Update(broadRects);
+		enemyBroadPhase.Pairs(broadPairs);
+		std::vector<std::pair<unsigned int, unsigned int>> enemyBullets;
+		for(const auto &p: broadPairs)
+			if(p.first < bulletCount && p.second >= bulletCount)
+				enemyBullets.push_back(std::pair<unsigned int, unsigned int>(p.second - bulletCount, p.first));
+		std::sort(enemyBullets.begin(), enemyBullets.end());
+		//overlap tests write one flag per pair, then hits are applied in pair order
+		std::vector<unsigned char> pairOverlap(enemyBullets.size(), 0);
+		gh::ParallelFor(enemyBullets.size(), PAIRS_PER_JOB, [&](unsigned int begin, unsigned int end) {
+			for(unsigned int i = begin; i < end; i++)
+				pairOverlap[i] = gh::colliding(broadRects[bulletCount + enemyBullets[i].first], broadRects[enemyBullets[i].second]);
+		});
+		std::vector<bool> bulletHit(bulletCount, false);
+		for(unsigned int i = 0; i < enemyBullets.size(); i++)
+		{
+			const auto &p = enemyBullets[i];
+			if(pairOverlap[i] && enemyChecked[p.first] && !bulletHit[p.second] && bullets.Active(p.second))
+			{
+				entities.HurtEnemy(awake[p.first], bullets.getMid(p.second));
+				bulletHit[p.second] = true;
+			}
+		}
+		//from the back so the bullet swapped in has already been checked
+		for(int i = (int)bulletCount - 1; i >= 0; i--)
+			if(bulletHit[i])
+				bullets.Remove(i);
+
+		for(unsigned int a = 0; a < enemyCount; a++)
+		{
+			unsigned int i = awake[a];
+			if(enemyChecked[a] && currentMap.name == "forgotten" && entities.EnemyShoot(i, currentMap.getOccupancy(), playerMid))
+			{
+				bullets.Spawn(entities.EnemyMid(i), glm::normalize(playerMid - entities.EnemyMid(i)) * 0.1f);
+			}
+		}
+		entities.RemoveDeadEnemies();
+
+		systemTimes.Start(gh::SimSystem::Bullets);
+		bullets.Update(timer, nonGapColliders, wallTiles);
+		for(unsigned int i = 0; i < bullets.Count(); i++)
+		{
+			if(gh::colliding(bullets.getRect(i), player.getDamageRect()))
+			{
+				bullets.Reverse(i, playerMid);
+				continue;
+			}
+			if(gh::colliding(bullets.getRect(i), player.getHitBox()))
+			{
+				player.Hurt(bullets.getMid(i));
+				bullets.Remove(i--);
+			}
+		}
+
+		//bullets bounce off each other after all have moved
+		systemTimes.Start(gh::SimSystem::BulletHits);
+		broadRects.resize(bullets.Count());
+		for(unsigned int i = 0; i < bullets.Count(); i++)
+			broadRects[i] = bullets.getRect(i);
+		bulletBroadPhase.Update(broadRects);
+		bulletBroadPhase.Pairs(broadPairs);
+		std::sort(broadPairs.begin(), broadPairs.end());
+		for(const auto &p: broadPairs)
+		{
+			if(gh::colliding(bullets.getRect(p.first), bullets.getRect(p.second)))
+			{
+				bullets.Reverse(p.first, bullets.getMid(p.second));
+				bullets.Reverse(p.second, bullets.getMid(p.first));
+			}
+		}
+		bullets.RemoveDead();
+
+		//after dying the player has moved, triggers are checked again from the new spot next tick
+		systemTimes.Start(gh::SimSystem::Triggers);
+		if(!player.Alive())
+		{
+			systemTimes.Start(gh::SimSystem::Respawn);
+			LoadMap(currentMap);
+		}
+		else
+			playerTriggers(triggerEvents);
+	}
+
+	systemTimes.Start(gh::SimSystem::Camera);
+	postUpdate();
+	systemTimes.Stop();
+	if(++tickCount == options.tickLimit)
+		closing = true;
+}
+
 void App::postUpdate()
 {
 	time += timer.FrameElapsed();
 	cam2D.Target(player.getMid(), timer);
-	currentMap.Update(cam2D.getCameraArea());
-	timer.Update();
 	previousInput = input;
 	input.offset = 0;
 }
 
+void App::interpolate(float alpha)
+{
+	player.Interpolate(alpha);
+	entities.Interpolate(alpha);
+	bullets.Interpolate(alpha);
+	cam2D.Interpolate(alpha);
+}
+
+
+
+void App::playerTriggers(const std::vector<TriggerHit> &triggerEvents)
+{
+	bool messageAdded = false;
+	for(const auto &e: triggerEvents)
+		if(e.type == TriggerType::Message && e.event != TriggerEvent::Exit)
+		{
+			for(const auto &s: messages[e.data].messages)
+			{
+				msgManager.AddMessage(*mRender, s);
+				messageAdded = true;
+			}
+			currentMap.triggers.Disable(e.trigger);
+		}
+	if(messageAdded)
+		return;
+	for(const auto &e: triggerEvents)
+		if(e.type == TriggerType::Item && e.event != TriggerEvent::Exit)
+		{
+			itemCount++;
+			if(currentMap.lastCheckpoint != glm::vec4(0))
+				player = Player(assets.playerAnim, currentMap.lastCheckpoint, &audio);
+			else
+				player = Player(assets.playerAnim, currentMap.getPlayerSpawn(), &audio);
+			entities.RemoveActiveEnemies();
+			//sent back, so not touching anything else from this tick
+			return;
+		}
+	if(itemCount < 4 && currentMap.name == "forgotten")
+		return;
+	for(const auto &e: triggerEvents)
+		if(e.type == TriggerType::ReactorTP && e.event != TriggerEvent::Exit)
+		{
+			if(currentMap.name == assets.forgottenMap.name)
+			{
+				assets.backInTime = Audio("audio/music/BackInTime.mp3");
+				assets.backInTime.setVolume(0.7f);
+				assets.backInTime.play();
+				//the new map's triggers start empty so won't send the reactor exit
+				leaveReactor();
+				currentMap = assets.remeberedMap;
+				LoadMap(currentMap);
+				messages.clear();
+				messages = currentMap.getMapMessages();
+			}
+			else
+			{
+				closing = true;
+			}
+			return;
+		}
+}
+
+void App::leaveReactor()
+{
+	if(inReactor)
+	{
+		music.play();
+		assets.reactorHum.stop();
+	}
+	inReactor = false;
+}
 
 void App::draw()
 {
@@ -415,9 +554,9 @@ void App::draw()
 		return;
 	finishedDrawSubmit = false;
 #endif
-	if(submitDraw.joinable())
-		submitDraw.join();
+	drawSubmit.Wait();
 
+	systemTimes.Start(gh::SimSystem::Draw);
 	mRender->set2DViewMatrix(cam2D.getViewMat());
 
 	mRender->begin2DDraw();
@@ -436,18 +575,14 @@ void App::draw()
 
 	player.Draw(*mRender, cam2D.getCameraArea());
 
-	for(auto &e: enemies)
-		e.Draw(*mRender, cam2D.getCameraArea());
-	for(auto &b: bullets)
-		b.Draw(*mRender);
-
-	for(auto &d: doors)
-		{
-			d.Draw(*mRender, cam2D.getCameraArea());
-		}
+	entities.Draw(*mRender, cam2D.getCameraArea(), Walker);
+	entities.Draw(*mRender, cam2D.getCameraArea(), Scientist);
+	bullets.Draw(*mRender);
+	entities.Draw(*mRender, cam2D.getCameraArea(), Door);
 	currentMap.Draw(*mRender);
 	
-	submitDraw = std::thread(&Render::endDraw, mRender, std::ref(finishedDrawSubmit));
+	drawSubmit.Run([this] { mRender->endDraw(finishedDrawSubmit); });
+	systemTimes.Stop();
 
 #ifdef TIME_APP_DRAW_UPDATE
 	auto stop = std::chrono::high_resolution_clock::now();
@@ -475,6 +610,7 @@ glm::vec2 App::correctedMouse()
 	return correctedPos(glm::vec2(input.X, input.Y)); 
 }
 
+#ifndef HEADLESS
 #pragma region GLFW_CALLBACKS
 
 
@@ -552,3 +688,4 @@ void App::error_callback(int error, const char* description)
 }
 
 #pragma endregion
+#endif
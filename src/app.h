@@ -1,10 +1,6 @@
 #ifndef APP_H
 #define APP_H
 
-#ifndef GLFW_INCLUDE_VULKAN
-#define GLFW_INCLUDE_VULKAN
-#endif
-#include <GLFW/glfw3.h>
 #ifndef GLM_FORCE_DEPTH_ZERO_TO_ONE
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #endif
@@ -12,14 +8,13 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <iostream>
-#include <thread>
 #include <stdexcept>
 #include <string>
 #include <atomic>
 #include <array>
+#include <algorithm>
 
-#include "vulkan-render/render.h"
-#include "vulkan-render/config.h"
+#include "renderer.h"
 #include "input.h"
 #include "audio.h"
 #include "timer.h"
@@ -28,11 +23,26 @@
 #include "animation.h"
 #include "message.h"
 #include "actors.h"
+#include "entities.h"
 #include "bullet.h"
+#include "spatialGrid.h"
+#include "sweepPrune.h"
+#include "flowField.h"
+#include "parallel.h"
+#include "jobSystem.h"
 #include "soundBank.h"
+#include "replay.h"
+#include "systemTimes.h"
+#include "stressScenario.h"
 //#define TIME_APP_DRAW_UPDATE
 //#define MULTI_UPDATE_ON_SLOW_DRAW
 
+//simulation runs in fixed steps, drawing interpolates between the last two
+const double SIM_STEP = 1000.0 / 60.0; //in ms
+const double MAX_FRAME_TIME = 250.0;
+const unsigned int PAIRS_PER_JOB = 256;
+const unsigned int HEADLESS_DEFAULT_TICKS = 60 * 60 * 5;
+
 struct AssetBank
 {
 	std::vector<Animation> playerAnim;
@@ -50,14 +60,28 @@ struct AssetBank
 	Map remeberedMap;
 };
 
+//how a run starts, from the command line
+struct RunOptions
+{
+	//records or plays back the input of every frame
+	gh::Replay *replay = nullptr;
+	//0 runs until closed
+	unsigned int tickLimit = 0;
+	//extra entities added around the player on every map load
+	unsigned int stressCount = 0;
+	//forgotten or remebered
+	std::string startMap = "forgotten";
+};
+
 class App
 {
 public:
-	App();
+	App(RunOptions options = RunOptions());
 	~App();
 	void run();
 	void resize(int windowWidth, int windowHeight);
 
+#ifndef HEADLESS
 #pragma region GLFW_CALLBACKS
 	static void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 	static void mouse_callback(GLFWwindow* window, double xpos, double ypos);
@@ -66,30 +90,46 @@ public:
 	static void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
 	static void error_callback(int error, const char* description);
 #pragma endregion
+#endif
 
 	Input input;
 private:
 	void loadAssets();
 	void update();
+	void tick();
 	void postUpdate();
+	void interpolate(float alpha);
+	void playerTriggers(const std::vector<TriggerHit> &triggerEvents);
+	void leaveReactor();
 	void draw();
 
 	void LoadMap(Map &map);
+	//colliders and the flow field over the map's active area
+	void buildMapColliders();
 
 	glm::vec2 correctedPos(glm::vec2 pos);
 	glm::vec2 appToScreen(glm::vec2 pos);
 
 	glm::vec2 correctedMouse();
 	
+#ifndef HEADLESS
 	GLFWwindow* mWindow;
+#endif
 	Render* mRender;
 	int mWindowWidth, mWindowHeight;
 	Input previousInput;
+	RunOptions options;
+	unsigned int tickCount = 0;
+	bool closing = false;
+	gh::SystemTimes systemTimes;
 	Timer timer;
+	Timer frameTimer;
+	double simAccumulator = 0;
 	camera::camera2D cam2D;
 
-	std::thread submitDraw;
-	std::atomic<bool> finishedDrawSubmit = true;
+	//endDraw blocks on present, so it runs on its own thread while the next update starts
+	gh::SubmitThread drawSubmit;
+	std::atomic<bool> finishedDrawSubmit{true};
 
 	float time = 0.0f;
 
@@ -98,14 +138,20 @@ private:
 	Audio audio;
 	Map currentMap;
 	std::vector<MapMessage> messages;
-	std::vector<Enemy> enemies;
+	EntityStore entities;
 	Player player;
 	AssetBank assets;
-	std::vector<glm::vec4> staticColliders;
-	std::vector<glm::vec4> nonGapColliders;
-
-	std::vector<Bullet> bullets;
-	std::vector<Door> doors;
+	gh::SpatialGrid staticColliders;
+	gh::SpatialGrid nonGapColliders;
+	//every tile the colliders above touch, moves clear of them all skip the grids
+	TileOccupancy wallTiles;
+	FlowField flowField;
+	//kept between ticks so the order and pair buffers are reused
+	gh::SweepAndPrune enemyBroadPhase;
+	gh::SweepAndPrune bulletBroadPhase;
+	std::vector<std::pair<unsigned int, unsigned int>> broadPairs;
+
+	BulletPool bullets;
 	bool inReactor = false;
 
 	int itemCount = 0;
@@ -2,7 +2,8 @@
 #define AUDIO_H
 
 
-#if defined(_WIN32) || defined(WIN32)
+//headless builds are always silent
+#if (defined(_WIN32) || defined(WIN32)) && !defined(HEADLESS)
 
 #include <tchar.h>
 #include <Windows.h>
@@ -123,7 +124,9 @@ class Audio
 public:
 	Audio(std::string filename)
 	{
+#ifndef HEADLESS
 		std::cout << "audio not supported on this OS" << std::endl;
+#endif
 	}
 	Audio() {}
 	~Audio()
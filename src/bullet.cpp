@@ -0,0 +1,171 @@
+#include "bullet.h"
+
+#ifdef BULLET_POOL_SSE
+#include <emmintrin.h>
+#endif
+
+BulletPool::BulletPool(Resource::Texture texture)
+{
+	this->texture = texture;
+	size = glm::vec2(texture.dim.x, texture.dim.y);
+	//sized to capacity so the batch loops can run past count to the next multiple of 4
+	posX.resize(MAX_BULLETS);
+	posY.resize(MAX_BULLETS);
+	prevX.resize(MAX_BULLETS);
+	prevY.resize(MAX_BULLETS);
+	velX.resize(MAX_BULLETS);
+	velY.resize(MAX_BULLETS);
+	age.resize(MAX_BULLETS);
+	hitTimer.resize(MAX_BULLETS);
+	hit.resize(MAX_BULLETS);
+}
+
+bool BulletPool::Spawn(glm::vec2 position, glm::vec2 velocity)
+{
+	if(count >= posX.size())
+		return false;
+	posX[count] = position.x;
+	posY[count] = position.y;
+	prevX[count] = position.x;
+	prevY[count] = position.y;
+	velX[count] = velocity.x;
+	velY[count] = velocity.y;
+	age[count] = 0;
+	hitTimer[count] = hitDelay;
+	hit[count] = 0;
+	count++;
+	return true;
+}
+
+void BulletPool::Update(Timer &timer, gh::SpatialGrid &colliders, const TileOccupancy &walls)
+{
+	float dt = (float)timer.FrameElapsed();
+	//ranges are whole blocks of 4, so no two threads write the same block
+	gh::ParallelFor(count, BULLETS_PER_JOB, [&](unsigned int begin, unsigned int end) {
+		updateRange(begin, end, dt, colliders, walls);
+	});
+}
+
+void BulletPool::updateRange(unsigned int begin, unsigned int end, float dt, gh::SpatialGrid &colliders, const TileOccupancy &walls)
+{
+#ifdef BULLET_POOL_SSE
+	__m128 dt4 = _mm_set1_ps(dt);
+	for(unsigned int i = begin; i < end; i += 4)
+	{
+		_mm_storeu_ps(&age[i], _mm_add_ps(_mm_loadu_ps(&age[i]), dt4));
+		_mm_storeu_ps(&hitTimer[i], _mm_add_ps(_mm_loadu_ps(&hitTimer[i]), dt4));
+	}
+#else
+	for(unsigned int i = begin; i < end; i++)
+	{
+		age[i] += dt;
+		hitTimer[i] += dt;
+	}
+#endif
+	integrate(begin, end, posX, prevX, velX, dt);
+	integrate(begin, end, posY, prevY, velY, dt);
+	collide(begin, end, colliders, walls);
+}
+
+void BulletPool::integrate(unsigned int begin, unsigned int end, std::vector<float> &pos, std::vector<float> &prevPos, std::vector<float> &vel, float dt)
+{
+#ifdef BULLET_POOL_SSE
+	__m128 dt4 = _mm_set1_ps(dt);
+	for(unsigned int i = begin; i < end; i += 4)
+	{
+		__m128 p = _mm_loadu_ps(&pos[i]);
+		_mm_storeu_ps(&prevPos[i], p);
+		_mm_storeu_ps(&pos[i], _mm_add_ps(p, _mm_mul_ps(_mm_loadu_ps(&vel[i]), dt4)));
+	}
+#else
+	for(unsigned int i = begin; i < end; i++)
+	{
+		prevPos[i] = pos[i];
+		pos[i] += vel[i] * dt;
+	}
+#endif
+}
+
+//redo the moves that end up touching a wall with a sweep, so bullets reflect at the contact at any step size
+void BulletPool::collide(unsigned int begin, unsigned int end, gh::SpatialGrid &colliders, const TileOccupancy &walls)
+{
+	for(unsigned int i = begin; i < end; i++)
+	{
+		glm::vec2 delta = glm::vec2(posX[i] - prevX[i], posY[i] - prevY[i]);
+		glm::vec4 bounds = glm::vec4(std::min(posX[i], prevX[i]), std::min(posY[i], prevY[i]),
+						size.x + std::abs(delta.x), size.y + std::abs(delta.y));
+		if((walls.Holds(bounds) && !walls.SolidIn(bounds)) || !colliders.Colliding(bounds))
+			continue;
+		glm::vec4 rect = glm::vec4(prevX[i], prevY[i], size.x, size.y);
+		glm::vec2 velocity = glm::vec2(velX[i], velY[i]);
+		if(colliders.MoveAndReflect(rect, delta, velocity))
+			hit[i] = 1;
+		posX[i] = rect.x;
+		posY[i] = rect.y;
+		velX[i] = velocity.x;
+		velY[i] = velocity.y;
+	}
+}
+
+void BulletPool::Draw(Render &render)
+{
+	for(unsigned int i = 0; i < count; i++)
+	{
+		glm::vec4 rect = glm::vec4(prevX[i] + (posX[i] - prevX[i]) * alpha, prevY[i] + (posY[i] - prevY[i]) * alpha,
+						size.x, size.y);
+		render.DrawQuad(texture, vkhelper::calcMatFromRect(rect, 0), glm::vec4(1.0f), glm::vec4(0, 0, 1, 1));
+	}
+}
+
+void BulletPool::Reverse(unsigned int i, glm::vec2 pos)
+{
+	hit[i] = 1;
+	if(hitTimer[i] > hitDelay)
+	{
+		hitTimer[i] = 0;
+		glm::vec2 velocity = glm::vec2(velX[i], velY[i]);
+		velocity = glm::normalize(getMid(i) - pos) * (glm::length(velocity) * 1.2f);
+		velX[i] = velocity.x;
+		velY[i] = velocity.y;
+		age[i] = 0;
+	}
+}
+
+void BulletPool::Remove(unsigned int i)
+{
+	count--;
+	if(i == count)
+		return;
+	posX[i] = posX[count];
+	posY[i] = posY[count];
+	prevX[i] = prevX[count];
+	prevY[i] = prevY[count];
+	velX[i] = velX[count];
+	velY[i] = velY[count];
+	age[i] = age[count];
+	hitTimer[i] = hitTimer[count];
+	hit[i] = hit[count];
+}
+
+void BulletPool::RemoveDead()
+{
+	if(count == 0)
+		return;
+	//from the back so the bullet swapped in has already been checked
+	for(int block = ((count - 1) / 4) * 4; block >= 0; block -= 4)
+	{
+#ifdef BULLET_POOL_SSE
+		int dead = _mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(&age[block]), _mm_set1_ps(lifespan)));
+		if(dead == 0)
+			continue;
+#else
+		int dead = 0;
+		for(int lane = 0; lane < 4; lane++)
+			if(age[block + lane] > lifespan)
+				dead |= 1 << lane;
+#endif
+		for(int lane = 3; lane >= 0; lane--)
+			if((dead & (1 << lane)) && (unsigned int)(block + lane) < count)
+				Remove(block + lane);
+	}
+}
@@ -1,117 +1,78 @@
-#ifndef BULLET_H 
+#ifndef BULLET_H
 #define BULLET_H
 
 #include <glm/glm.hpp>
+#include <vector>
+#include <algorithm>
 
-#include "vulkan-render/render.h"
-#include "vulkan-render/texture_loader.h"
-#include "vulkan-render/vkhelper.h"
+#include "renderer.h"
 #include "timer.h"
 #include "gamehelper.h"
+#include "spatialGrid.h"
+#include "tileOccupancy.h"
+#include "parallel.h"
 
-class Bullet
-{
-public:
-	Bullet(Resource::Texture texture, glm::vec2 position, glm::vec2 velocity)
-	{
-		this->texture = texture;
-		this->rect = glm::vec4(position.x, position.y, texture.dim.x, texture.dim.y);
-		this->velocity = velocity;
-	}
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BULLET_POOL_SSE
+#endif
 
-	void Update(Timer &timer, std::vector<glm::vec4> &colliders)
-	{
-		this->timer += timer.FrameElapsed(); 
-		hitTimer += timer.FrameElapsed();
-		float prevX = rect.x;
-		rect.x += velocity.x * timer.FrameElapsed();
-		for(const auto &mRect: colliders)
-		{
-			if(gh::colliding(mRect, rect))
-			{
-				hit = true;
-				rect.x = prevX;
-				velocity.x *= -1;
-				break;
-			}
-		}
-		float prevY = rect.y;
-		rect.y += velocity.y * timer.FrameElapsed();
-		for(const auto &mRect: colliders)
-		{
-			if(gh::colliding(mRect, rect))
-			{
-				hit = true;
-				rect.y = prevY;
-				velocity.y *= -1;
-				break;
-			}
-		}
-
-		mat = vkhelper::calcMatFromRect(rect, 0);
-	}
-
-	void Draw(Render &render)
-	{
-		render.DrawQuad(texture, mat, colour, glm::vec4(0, 0, 1, 1));
-	}
-
-	void Reverse(glm::vec2 pos, glm::vec4 colour)
-	{
-		hit = true;
-		if(hitTimer > hitDelay)
-		{
-			hitTimer = 0;
-			velocity = glm::normalize(this->getMid() - pos) * (glm::length(velocity) * 1.2f);
-			this->colour = colour;
-			timer = 0;
-		}
-	}
+const unsigned int MAX_BULLETS = 4096;
+//must stay a multiple of 4 for the batched update
+const unsigned int BULLETS_PER_JOB = 256;
 
-	bool Dead()
+//all bullets share a texture, state is kept as separate arrays so the update runs 4 bullets at a time.
+//indices are only stable until a bullet is removed, removal swaps the last bullet in
+class BulletPool
+{
+public:
+	BulletPool() {}
+	BulletPool(Resource::Texture texture);
+
+	//false if the pool is full
+	bool Spawn(glm::vec2 position, glm::vec2 velocity);
+	void Update(Timer &timer, gh::SpatialGrid &colliders, const TileOccupancy &walls);
+	void Draw(Render &render);
+	//drawn between the position before and after the last update, 1 is the latest
+	void Interpolate(float alpha) { this->alpha = alpha; }
+	void SavePrevious()
 	{
-		return lifespan < timer;
+		std::copy(posX.begin(), posX.begin() + count, prevX.begin());
+		std::copy(posY.begin(), posY.begin() + count, prevY.begin());
 	}
 
-	bool Active()
-	{
-		return hit;
-	}
+	void Reverse(unsigned int i, glm::vec2 pos);
+	void Remove(unsigned int i);
+	void RemoveDead();
+	void Clear() { count = 0; }
 
-	glm::vec4 getRect()
-	{
-		return rect;
-	}
+	bool Active(unsigned int i) { return hit[i] != 0; }
+	bool Dead(unsigned int i) { return age[i] > lifespan; }
+	glm::vec4 getRect(unsigned int i) { return glm::vec4(posX[i], posY[i], size.x, size.y); }
+	glm::vec2 getMid(unsigned int i) { return glm::vec2(posX[i] + size.x/2, posY[i] + size.y/2); }
+	unsigned int Count() { return count; }
 
-	glm::vec2 getMid()
-	{
-		return glm::vec2(rect.x + rect.z/2, rect.y + rect.w/2);
-	}
+private:
+	void updateRange(unsigned int begin, unsigned int end, float dt, gh::SpatialGrid &colliders, const TileOccupancy &walls);
+	void integrate(unsigned int begin, unsigned int end, std::vector<float> &pos, std::vector<float> &prevPos, std::vector<float> &vel, float dt);
+	void collide(unsigned int begin, unsigned int end, gh::SpatialGrid &colliders, const TileOccupancy &walls);
 
-protected:
 	Resource::Texture texture;
-	glm::vec4 rect;
-	glm::mat4 mat;
-	glm::vec2 velocity;
-	float speed;
-	glm::vec4 colour = glm::vec4(1.0f);
+	glm::vec2 size = glm::vec2(0);
+	unsigned int count = 0;
+	float alpha = 1.0f;
+
+	std::vector<float> posX;
+	std::vector<float> posY;
+	std::vector<float> prevX;
+	std::vector<float> prevY;
+	std::vector<float> velX;
+	std::vector<float> velY;
+	std::vector<float> age;
+	std::vector<float> hitTimer;
+	std::vector<unsigned char> hit;
 
 	float lifespan = 10000;
-	float timer = 0;
 	float hitDelay = 1000;
-	float hitTimer = 1000;
-	bool hit = false;
-};
-
-class Particle : public Bullet
-{
-	Particle(Resource::Texture texture, glm::vec2 position, glm::vec2 velocity)
-		: Bullet(texture, position, velocity)
-		{
-			
-		}
 };
 
-
-
-#endif
\ No newline at end of file
+#endif
@@ -79,29 +79,24 @@ namespace camera
 				
 			glm::vec2 transform = glm::vec2(0);
 
-			if(mapRect.z == 0 && cameraRects.size() == 0)
+			if(mapRect.z == 0 && rooms.Count() == 0)
 			{
 				transform.x = -focus.x;
 				transform.y = -focus.y;
 			}
-			else if(cameraRects.size() == 0)
+			else if(rooms.Count() == 0)
 			{
 				transform.x = getOffset(settings::TARGET_WIDTH, focus.x, mapRect.x, mapRect.z);
 				transform.y = getOffset(settings::TARGET_HEIGHT, focus.y, mapRect.y, mapRect.w);
 			}
 			else
 			{
-				glm::vec4 newRect = glm::vec4(0);
-				currentRoom = glm::vec4(0);
-				for(const auto& rect: cameraRects)
-				{
-					if(gh::contains(focus, rect))
-					{ 
-						newRect = rect;
-						currentRoom = rect;
-						break;
-					}
-				}
+				//starts from the room the focus was last in and its neighbours
+				int roomIndex = rooms.Find(focus, lastRoomIndex);
+				if(roomIndex != -1)
+					lastRoomIndex = roomIndex;
+				glm::vec4 newRect = rooms.Room(roomIndex);
+				currentRoom = newRect;
 				if(newRect == glm::vec4(0))
 				{
 					transform.x = -focus.x;
@@ -129,9 +124,17 @@ namespace camera
 			transform = previousOff;
 			}
 
+			previousOff = transform;
+			lastTickTransform = tickTransform;
+			tickTransform = transform;
+			Interpolate(1.0f);
+		}
+
+	void camera2D::Interpolate(float alpha)
+		{
+			glm::vec2 transform = lastTickTransform + (tickTransform - lastTickTransform) * alpha;
 			cameraArea = glm::vec4(-transform.x - settings::TARGET_WIDTH/2, -transform.y - settings::TARGET_HEIGHT/2,
 									 settings::TARGET_WIDTH, settings::TARGET_HEIGHT);
-			previousOff = transform;
 			offset = glm::translate(glm::mat4(1.0f), glm::vec3(transform.x + settings::TARGET_WIDTH/2,
 				 					transform.y + settings::TARGET_HEIGHT/2, 0));
 		}
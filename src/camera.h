@@ -1,10 +1,6 @@
 #ifndef FREE_CAMERA_H
 #define FREE_CAMERA_H
 
-#ifndef GLFW_INCLUDE_VULKAN
-#define GLFW_INCLUDE_VULKAN
-#endif
-#include <GLFW/glfw3.h>
 #ifndef GLM_FORCE_DEPTH_ZERO_TO_ONE
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #endif
@@ -18,7 +14,8 @@
 #include "input.h"
 #include "timer.h"
 #include "gamehelper.h"
-#include "vulkan-render/config.h"
+#include "roomGraph.h"
+#include "renderer.h"
 
 namespace camera
 {
@@ -78,9 +75,13 @@ namespace camera
 			 settings::TARGET_WIDTH, settings::TARGET_HEIGHT);
 			offset = glm::translate(glm::mat4(1.0f),
 				 glm::vec3(-pos.x + settings::TARGET_WIDTH/2, -pos.y + settings::TARGET_HEIGHT/2, 0));
+			tickTransform = -pos;
+			lastTickTransform = tickTransform;
 		}
 
 		void Target(glm::vec2 focus, Timer &timer);
+		//sets the view and area between the last two targets, alpha 0 is the older one
+		void Interpolate(float alpha);
 
 
 		glm::mat4 getViewMat()
@@ -89,7 +90,8 @@ namespace camera
 		}
 		void setCameraRects(std::vector<glm::vec4> cameraRects)
 		{
-			this->cameraRects = cameraRects;
+			rooms = gh::RoomGraph(cameraRects, gh::ROOM_ADJACENCY_GAP);
+			lastRoomIndex = -1;
 		}
 		void setCameraMapRect(glm::vec4 mapRect)
 		{
@@ -97,7 +99,8 @@ namespace camera
 		}
 		void clearCameraRects()
 		{
-			cameraRects.clear();
+			rooms = gh::RoomGraph();
+			lastRoomIndex = -1;
 			mapRect = glm::vec4(0);
 		}
 
@@ -111,14 +114,27 @@ namespace camera
 			return glm::vec2(cameraArea.x, cameraArea.y);
 		}
 
+		const gh::RoomGraph& getRooms()
+		{
+			return rooms;
+		}
+		//the room the focus was last in, stays set while the focus is between rooms
+		int getLastRoom()
+		{
+			return lastRoomIndex;
+		}
+
 		glm::vec4 currentRoom = glm::vec4(0);
 	private:
 		glm::mat4 offset = glm::mat4(1.0f);
-		std::vector<glm::vec4> cameraRects;
+		gh::RoomGraph rooms;
+		int lastRoomIndex = -1;
 		glm::vec4 mapRect =  glm::vec4(0);
 
 		glm::vec4 currentRect = glm::vec4(0, 0, 0, 0);
 		glm::vec2 previousOff = glm::vec2(0);
+		glm::vec2 tickTransform = glm::vec2(0);
+		glm::vec2 lastTickTransform = glm::vec2(0);
 
 		glm::vec4 cameraArea = glm::vec4(0);
 	};
@@ -0,0 +1,519 @@
+#include "entities.h"
+
+void EntityTable::Add(glm::vec2 position, AnimationType direction)
+{
+	Playhead p;
+	p.direction = direction;
+	const Frame &f = animations[direction][0];
+	hitbox.push_back(glm::vec4(position.x, position.y, f.size.x, f.size.y));
+	sprite.push_back(hitbox.back());
+	prevPos.push_back(position);
+	motion.push_back(EntityMotion());
+	EntityHealth h;
+	h.health = maxHealth;
+	health.push_back(h);
+	playhead.push_back(p);
+	ai.push_back(EntityAI());
+	room.push_back(-1);
+}
+
+template <typename T>
+static void compact(std::vector<T> &column, const std::vector<unsigned char> &removed)
+{
+	size_t kept = 0;
+	for(size_t i = 0; i < column.size(); i++)
+		if(!removed[i])
+			column[kept++] = column[i];
+	column.resize(kept);
+}
+
+//keeps order so updates run in spawn order like before
+void EntityTable::Remove(const std::vector<unsigned char> &removed)
+{
+	compact(hitbox, removed);
+	compact(sprite, removed);
+	compact(prevPos, removed);
+	compact(motion, removed);
+	compact(health, removed);
+	compact(playhead, removed);
+	compact(ai, removed);
+	compact(room, removed);
+}
+
+void EntityTable::Clear()
+{
+	hitbox.clear();
+	sprite.clear();
+	prevPos.clear();
+	motion.clear();
+	health.clear();
+	playhead.clear();
+	ai.clear();
+	room.clear();
+}
+
+static std::vector<std::vector<Frame>> framesOf(std::vector<Animation> animations)
+{
+	std::vector<std::vector<Frame>> frames;
+	for(auto &a: animations)
+		frames.push_back(a.getAllFrames());
+	return frames;
+}
+
+EntityStore::EntityStore(std::vector<Animation> walker, Resource::Texture scientist, Audio *audio)
+{
+	tables[Walker].animations = framesOf(walker);
+	tables[Walker].hurtSound = SoundEffectBank("audio/sfx/stab/wet/", 100, 10, 0.4, audio);
+	tables[Walker].maxHealth = 2;
+	tables[Walker].maxSpeed = 0.03f;
+
+	Animation still(scientist, 200, 22);
+	tables[Scientist].animations = framesOf({still, still, still, still});
+	tables[Scientist].hurtSound = SoundEffectBank("audio/sfx/stab/dry/", 100, 10, 0.4, audio);
+	tables[Scientist].maxHealth = 2;
+	tables[Scientist].maxSpeed = 0.03f;
+
+	tables[Door].openSound = SoundEffectBank("audio/sfx/door/open/", 100, 10, 0.4, audio);
+	tables[Door].closeSound = SoundEffectBank("audio/sfx/door/close/", 100, 10, 0.4, audio);
+}
+
+void EntityStore::SetDoorAnimations(std::vector<Animation> door)
+{
+	tables[Door].animations = framesOf(door);
+}
+
+void EntityStore::Clear()
+{
+	for(auto &t: tables)
+		t.Clear();
+	bucketsDirty = true;
+}
+
+void EntityStore::Spawn(EntityArchetype type, glm::vec2 position)
+{
+	EntityTable &t = tables[type];
+	bucketsDirty = true;
+	switch(type)
+	{
+		case Walker:
+			t.Add(position, AnimationType::Down);
+			t.motion.back().velocity.x = t.maxSpeed;
+			t.ai.back().shootDelay = baseShootDelay + (rand.Real() * 1000);
+			break;
+		case Scientist:
+			t.Add(position, AnimationType::Up);
+			break;
+		case Door:
+			t.Add(position, AnimationType::Down);
+			break;
+	}
+}
+
+void EntityStore::Wake(const gh::RoomGraph &rooms, int room, glm::vec4 nearArea)
+{
+	sightChecks = 0;
+	awakeEnemies.clear();
+	if(rooms.Count() == 0)
+	{
+		for(unsigned int a = 0; a < ENEMY_ARCHETYPE_COUNT; a++)
+		{
+			awake[a].resize(tables[a].size());
+			for(unsigned int i = 0; i < awake[a].size(); i++)
+				awake[a][i] = i;
+		}
+	}
+	else
+	{
+		if(bucketsDirty || roomBuckets[Walker].size() != rooms.Count())
+			bucketRooms(rooms);
+		gatherAwake(rooms, room);
+		//only enemies that were awake can have moved to another room
+		for(unsigned int a = 0; a < ENEMY_ARCHETYPE_COUNT; a++)
+		{
+			EntityTable &t = tables[a];
+			for(auto i: awake[a])
+			{
+				int r = rooms.Find(t.mid(i), t.room[i]);
+				if(r != -1 && r != t.room[i])
+				{
+					t.room[i] = r;
+					bucketsDirty = true;
+				}
+			}
+		}
+		if(bucketsDirty)
+		{
+			bucketRooms(rooms);
+			gatherAwake(rooms, room);
+		}
+	}
+	for(auto i: awake[Walker])
+		awakeEnemies.push_back(i);
+	for(auto i: awake[Scientist])
+		awakeEnemies.push_back(tables[Walker].size() + i);
+	scheduleDue(nearArea);
+}
+
+//far enemies are spread over the interval by index so each tick does a similar amount
+void EntityStore::scheduleDue(glm::vec4 nearArea)
+{
+	for(unsigned int a = 0; a < ENEMY_ARCHETYPE_COUNT; a++)
+	{
+		EntityTable &t = tables[a];
+		due[a].clear();
+		for(auto i: awake[a])
+			if(gh::colliding(t.sprite[i], nearArea) || (i + ticks) % AI_LOD_FAR_INTERVAL == 0)
+				due[a].push_back(i);
+	}
+}
+
+void EntityStore::gatherAwake(const gh::RoomGraph &rooms, int room)
+{
+	for(unsigned int a = 0; a < ENEMY_ARCHETYPE_COUNT; a++)
+	{
+		awake[a].clear();
+		if(room < 0)
+			continue;
+		awake[a].insert(awake[a].end(), roomBuckets[a][room].begin(), roomBuckets[a][room].end());
+		for(auto n = rooms.NeighboursBegin(room); n != rooms.NeighboursEnd(room); n++)
+			awake[a].insert(awake[a].end(), roomBuckets[a][*n].begin(), roomBuckets[a][*n].end());
+		std::sort(awake[a].begin(), awake[a].end());
+	}
+}
+
+//enemies keep their last room while between rooms, ones placed outside every room go to the nearest
+void EntityStore::bucketRooms(const gh::RoomGraph &rooms)
+{
+	for(unsigned int a = 0; a < ENEMY_ARCHETYPE_COUNT; a++)
+	{
+		EntityTable &t = tables[a];
+		roomBuckets[a].assign(rooms.Count(), std::vector<unsigned int>());
+		for(unsigned int i = 0; i < t.size(); i++)
+		{
+			if(t.room[i] < 0 || t.room[i] >= (int)rooms.Count())
+			{
+				t.room[i] = rooms.Find(t.mid(i), -1);
+				if(t.room[i] == -1)
+					t.room[i] = rooms.Nearest(t.mid(i));
+			}
+			roomBuckets[a][t.room[i]].push_back(i);
+		}
+	}
+	bucketsDirty = false;
+}
+
+void EntityStore::Update(Timer &timer, gh::SpatialGrid &colliders, const TileOccupancy &walls, glm::vec4 currentRoom, const FlowField &flow)
+{
+	float dt = (float)timer.FrameElapsed();
+	ticks++;
+	for(unsigned int a = 0; a < ENEMY_ARCHETYPE_COUNT; a++)
+		for(auto i: awake[a])
+			tables[a].ai[i].pendingDt += dt;
+	//each entity only writes its own columns, so ranges can run on any thread
+	gh::ParallelFor(due[Walker].size(), ENTITIES_PER_JOB, [&](unsigned int begin, unsigned int end) {
+		updateWalkers(begin, end, colliders, walls, currentRoom, flow);
+	});
+	gh::ParallelFor(due[Scientist].size(), ENTITIES_PER_JOB, [&](unsigned int begin, unsigned int end) {
+		updateScientists(begin, end, colliders, walls, currentRoom);
+	});
+	EntityTable &doors = tables[Door];
+	doorEvents.assign(doors.size(), 0);
+	gh::ParallelFor(doors.size(), ENTITIES_PER_JOB, [&](unsigned int begin, unsigned int end) {
+		updateDoors(begin, end, dt);
+	});
+	//sounds are played after, in door order
+	for(unsigned int i = 0; i < doors.size(); i++)
+	{
+		if(doorEvents[i] > 0)
+			doors.openSound.PlayOnce();
+		else if(doorEvents[i] < 0)
+			doors.closeSound.PlayOnce();
+	}
+}
+
+void EntityStore::updateWalkers(unsigned int begin, unsigned int end, gh::SpatialGrid &colliders, const TileOccupancy &walls, glm::vec4 currentRoom, const FlowField &flow)
+{
+	EntityTable &t = tables[Walker];
+	for(unsigned int a = begin; a < end; a++)
+	{
+		unsigned int i = due[Walker][a];
+		float dt = t.ai[i].pendingDt;
+		t.ai[i].pendingDt = 0;
+		if(!t.ai[i].active)
+		{
+			if(gh::colliding(t.hitbox[i], currentRoom))
+				t.ai[i].active = true;
+			continue;
+		}
+		t.ai[i].shootTimer += dt;
+		if(t.ai[i].sightRetryTimer > 0)
+			t.ai[i].sightRetryTimer -= dt;
+#ifndef PATROLLING_WALKERS
+		glm::vec2 dir = flow.Sample(t.mid(i));
+#else
+		glm::vec2 dir = glm::vec2(0);
+#endif
+		//out of the field's range they patrol, speed is kept by manhattan length like the rest of the movement
+		if(dir != glm::vec2(0))
+			t.motion[i].velocity = dir * (t.maxSpeed / (std::abs(dir.x) + std::abs(dir.y)));
+		else if(t.ai[i].collided)
+			t.motion[i].velocity = -t.motion[i].velocity;
+		move(t, i, dt, colliders, walls);
+	}
+}
+
+void EntityStore::updateScientists(unsigned int begin, unsigned int end, gh::SpatialGrid &colliders, const TileOccupancy &walls, glm::vec4 currentRoom)
+{
+	EntityTable &t = tables[Scientist];
+	for(unsigned int a = begin; a < end; a++)
+	{
+		unsigned int i = due[Scientist][a];
+		float dt = t.ai[i].pendingDt;
+		t.ai[i].pendingDt = 0;
+		if(!t.ai[i].active && gh::colliding(t.hitbox[i], currentRoom))
+			t.ai[i].active = true;
+		if(t.ai[i].active)
+		{
+			t.ai[i].shootTimer += dt;
+			if(t.ai[i].sightRetryTimer > 0)
+				t.ai[i].sightRetryTimer -= dt;
+		}
+		//scientists stand still facing up, only moving when knocked back
+		t.motion[i].velocity = glm::vec2(0);
+		move(t, i, dt, colliders, walls);
+		t.playhead[i].direction = AnimationType::Up;
+		t.playhead[i].frame = 0;
+	}
+}
+
+void EntityStore::DoorPlayerNear(unsigned int door, glm::vec2 player)
+{
+	EntityTable &t = tables[Door];
+	float dist = std::abs(t.hitbox[door].x - player.x) + std::abs(t.hitbox[door].y - player.y);
+	t.ai[door].inRange = dist < DOOR_TRIGGER_RANGE;
+}
+
+void EntityStore::updateDoors(unsigned int begin, unsigned int end, float dt)
+{
+	EntityTable &t = tables[Door];
+	for(unsigned int i = begin; i < end; i++)
+	{
+		bool inRange = t.ai[i].inRange;
+		bool open = t.playhead[i].direction == AnimationType::Up;
+		if(inRange != open)
+		{
+			doorEvents[i] = inRange ? 1 : -1;
+			//the other animation starts from its first frame
+			t.playhead[i].frame = 0;
+			t.playhead[i].timer = 0;
+			t.playhead[i].done = false;
+		}
+		t.playhead[i].direction = inRange ? AnimationType::Up : AnimationType::Down;
+		play(t, i, dt, true);
+		t.sprite[i] = t.hitbox[i];
+	}
+}
+
+//same steps as Actor::Update
+void EntityStore::move(EntityTable &t, unsigned int i, float dt, gh::SpatialGrid &colliders, const TileOccupancy &walls)
+{
+	EntityMotion &m = t.motion[i];
+	EntityHealth &h = t.health[i];
+	if(std::abs(m.velocity.x) + std::abs(m.velocity.y) > t.maxSpeed)
+		m.velocity /= 1.5f;
+	h.pushTimer += dt;
+	if(h.pushTimer < pushDelay)
+		m.velocity = h.pushDir;
+	glm::vec2 delta = m.velocity * dt;
+	glm::vec4 swept = gh::sweptRect(t.hitbox[i], delta);
+	if(walls.Holds(swept) && !walls.SolidIn(swept) && !walls.GapIn(swept))
+	{
+		t.hitbox[i].x += delta.x;
+		t.hitbox[i].y += delta.y;
+		t.ai[i].collided = false;
+	}
+	else
+		t.ai[i].collided = colliders.MoveAndSlide(t.hitbox[i], delta);
+
+	if(h.pushTimer > pushDelay)
+	{
+		Playhead &p = t.playhead[i];
+		glm::vec2 dir = m.velocity == glm::vec2(0) ? m.prevDir : m.velocity;
+		if(dir.x < 0)
+			p.direction = AnimationType::Left;
+		else if(dir.x > 0)
+			p.direction = AnimationType::Right;
+		else if(dir.y < 0)
+			p.direction = AnimationType::Up;
+		else if(dir.y > 0)
+			p.direction = AnimationType::Down;
+		if(m.velocity == glm::vec2(0))
+			p.frame = 0;
+		else
+		{
+			play(t, i, dt, false);
+			m.prevDir = m.velocity;
+		}
+	}
+	const Frame &f = t.frame(i);
+	t.sprite[i] = glm::vec4(t.hitbox[i].x, t.hitbox[i].y, f.size.x, f.size.y);
+	t.ai[i].colour = glm::vec4(1.0f);
+}
+
+void EntityStore::play(EntityTable &t, unsigned int i, float dt, bool once)
+{
+	Playhead &p = t.playhead[i];
+	const std::vector<Frame> &frames = t.animations[p.direction];
+	if(p.frame >= frames.size())
+		p.frame = 0;
+	if(once && p.done)
+		return;
+	p.timer += dt;
+	if(p.timer > frames[p.frame].delay)
+	{
+		p.timer = 0;
+		p.frame++;
+		if(p.frame >= frames.size())
+		{
+			if(once)
+			{
+				p.done = true;
+				p.frame--;
+			}
+			else
+				p.frame = 0;
+		}
+	}
+}
+
+void EntityStore::SavePrevious()
+{
+	for(auto &t: tables)
+		for(unsigned int i = 0; i < t.size(); i++)
+			t.prevPos[i] = glm::vec2(t.sprite[i].x, t.sprite[i].y);
+}
+
+void EntityStore::Draw(Render &render, glm::vec4 cameraRect, EntityArchetype type)
+{
+	EntityTable &t = tables[type];
+	for(unsigned int i = 0; i < t.size(); i++)
+	{
+		if(!gh::colliding(t.sprite[i], cameraRect))
+			continue;
+		glm::vec4 rect = t.sprite[i];
+		rect.x = t.prevPos[i].x + (rect.x - t.prevPos[i].x) * alpha;
+		rect.y = t.prevPos[i].y + (rect.y - t.prevPos[i].y) * alpha;
+		glm::vec4 colour = t.health[i].pushTimer < pushDelay ? glm::vec4(1, 0, 0, 1) : t.ai[i].colour;
+		const Frame &f = t.frame(i);
+		render.DrawQuad(f.tex, vkhelper::calcMatFromRect(rect, 0), colour, f.textureOffset);
+	}
+}
+
+EntityTable& EntityStore::enemyTable(unsigned int &i)
+{
+	if(i < tables[Walker].size())
+		return tables[Walker];
+	i -= tables[Walker].size();
+	return tables[Scientist];
+}
+
+bool EntityStore::EnemyActive(unsigned int i)
+{
+	EntityTable &t = enemyTable(i);
+	return t.ai[i].active;
+}
+
+glm::vec4 EntityStore::EnemyHitBox(unsigned int i)
+{
+	EntityTable &t = enemyTable(i);
+	return t.hitbox[i];
+}
+
+glm::vec2 EntityStore::EnemyMid(unsigned int i)
+{
+	EntityTable &t = enemyTable(i);
+	return t.mid(i);
+}
+
+void EntityStore::HurtEnemy(unsigned int i, glm::vec2 hurtLoc)
+{
+	EntityTable &t = enemyTable(i);
+	EntityHealth &h = t.health[i];
+	if(h.pushTimer > invDelay)
+	{
+		t.hurtSound.PlayOnce();
+		h.pushTimer = 0;
+		h.health -= 1;
+		h.pushDir = glm::normalize(t.mid(i) - hurtLoc) * (t.maxSpeed * pushFactor);
+	}
+}
+
+//walkers and scientists both shoot, holding fire while a wall blocks the target.
+//a scientist's first shot is ready as soon as it is active
+bool EntityStore::EnemyShoot(unsigned int i, const TileOccupancy &occupancy, glm::vec2 target)
+{
+	EntityTable &t = enemyTable(i);
+	EntityAI &a = t.ai[i];
+	//the shot stays ready while blocked, so the warning tint isn't shown again
+	if(a.shootTimer > a.shootDelay && a.sightRetryTimer <= 0 && sightChecks < AI_SIGHT_CHECKS_PER_TICK)
+	{
+		sightChecks++;
+		if(occupancy.LineOfSight(t.mid(i), target))
+		{
+			a.shootTimer = 0;
+			a.shootDelay = baseShootDelay + (rand.Real() * 1000);
+			return true;
+		}
+		a.sightRetryTimer = AI_SIGHT_RETRY;
+	}
+	float left = a.shootDelay - a.shootTimer;
+	if(left < 500 && left > 1)
+	{
+		float close = left/500;
+		a.colour = glm::vec4(close, close, close, 1);
+	}
+	return false;
+}
+
+//flags them all first, so the columns are compacted once however many die in a tick
+void EntityStore::RemoveDeadEnemies()
+{
+	for(unsigned int a = 0; a < ENEMY_ARCHETYPE_COUNT; a++)
+	{
+		EntityTable &t = tables[a];
+		bool any = false;
+		removed.assign(t.size(), 0);
+		for(unsigned int i = 0; i < t.size(); i++)
+			if(t.health[i].health <= 0 && t.health[i].pushTimer >= pushDelay)
+			{
+				removed[i] = 1;
+				any = true;
+			}
+		if(any)
+		{
+			t.Remove(removed);
+			bucketsDirty = true;
+		}
+	}
+}
+
+void EntityStore::RemoveActiveEnemies()
+{
+	for(unsigned int a = 0; a < ENEMY_ARCHETYPE_COUNT; a++)
+	{
+		EntityTable &t = tables[a];
+		bool any = false;
+		removed.assign(t.size(), 0);
+		for(unsigned int i = 0; i < t.size(); i++)
+			if(t.ai[i].active)
+			{
+				removed[i] = 1;
+				any = true;
+			}
+		if(any)
+		{
+			t.Remove(removed);
+			bucketsDirty = true;
+		}
+	}
+}
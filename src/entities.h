@@ -0,0 +1,173 @@
+#ifndef ENTITIES_H
+#define ENTITIES_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <array>
+
+#include "renderer.h"
+#include "animation.h"
+#include "actors.h"
+#include "timer.h"
+#include "gamehelper.h"
+#include "spatialGrid.h"
+#include "roomGraph.h"
+#include "tileOccupancy.h"
+#include "triggers.h"
+#include "flowField.h"
+#include "soundBank.h"
+#include "parallel.h"
+
+enum EntityArchetype
+{
+	Walker = 0,
+	Scientist = 1,
+	Door = 2,
+};
+const unsigned int ARCHETYPE_COUNT = 3;
+//walkers then scientists make up the enemy index range
+const unsigned int ENEMY_ARCHETYPE_COUNT = 2;
+const unsigned int ENTITIES_PER_JOB = 64;
+
+//awake enemies touching the near area update every tick, the rest every few ticks with the time they missed
+const unsigned int AI_LOD_FAR_INTERVAL = 4;
+//line of sight checks for shooting, later enemies wait for the next tick
+const unsigned int AI_SIGHT_CHECKS_PER_TICK = 16;
+//ms before an enemy without sight of the player checks again
+const float AI_SIGHT_RETRY = 250;
+
+//walkers bounce back and forth like before instead of following the flow field to the player
+//#define PATROLLING_WALKERS
+
+struct EntityMotion
+{
+	glm::vec2 velocity = glm::vec2(0);
+	glm::vec2 prevDir = glm::vec2(0);
+};
+
+struct EntityHealth
+{
+	int health = 0;
+	float pushTimer = 150;
+	glm::vec2 pushDir = glm::vec2(0);
+};
+
+struct Playhead
+{
+	unsigned int frame = 0;
+	float timer = 0;
+	bool done = false;
+	AnimationType direction = AnimationType::Down;
+};
+
+struct EntityAI
+{
+	bool active = false;
+	bool collided = false;
+	bool inRange = false;
+	float shootTimer = 0;
+	float shootDelay = 0;
+	//time until line of sight is checked again after a wall blocked a shot
+	float sightRetryTimer = 0;
+	//time not yet updated for, when on the far level of detail
+	float pendingDt = 0;
+	glm::vec4 colour = glm::vec4(1.0f);
+};
+
+//one packed column per component, everything shared by the archetype is stored once
+struct EntityTable
+{
+	std::vector<glm::vec4> hitbox;
+	std::vector<glm::vec4> sprite;
+	std::vector<glm::vec2> prevPos;
+	std::vector<EntityMotion> motion;
+	std::vector<EntityHealth> health;
+	std::vector<Playhead> playhead;
+	std::vector<EntityAI> ai;
+	//room graph index, -1 until the store places it
+	std::vector<int> room;
+
+	std::vector<std::vector<Frame>> animations;
+	SoundEffectBank hurtSound;
+	SoundEffectBank openSound;
+	SoundEffectBank closeSound;
+	int maxHealth = 2;
+	float maxSpeed = 0.03f;
+
+	unsigned int size() { return (unsigned int)hitbox.size(); }
+	void Add(glm::vec2 position, AnimationType direction);
+	//removes every entity flagged in removed in one pass over each column
+	void Remove(const std::vector<unsigned char> &removed);
+	void Clear();
+	const Frame& frame(unsigned int i) { return animations[playhead[i].direction][playhead[i].frame]; }
+	glm::vec2 mid(unsigned int i) { return glm::vec2(sprite[i].x + sprite[i].z/2, sprite[i].y + sprite[i].w/2); }
+};
+
+class EntityStore
+{
+public:
+	EntityStore() {}
+	EntityStore(std::vector<Animation> walker, Resource::Texture scientist, Audio *audio);
+
+	void SetDoorAnimations(std::vector<Animation> door);
+	void Clear();
+	void Spawn(EntityArchetype type, glm::vec2 position);
+
+	//enemies in room and its neighbours are awake, the rest are skipped until they are near again.
+	//awake enemies outside nearArea are only updated every AI_LOD_FAR_INTERVAL ticks
+	void Wake(const gh::RoomGraph &rooms, int room, glm::vec4 nearArea);
+	void Update(Timer &timer, gh::SpatialGrid &colliders, const TileOccupancy &walls, glm::vec4 currentRoom, const FlowField &flow);
+	//from door trigger events, doors open while the player is in range
+	void DoorPlayerNear(unsigned int door, glm::vec2 player);
+	void DoorPlayerLeft(unsigned int door) { tables[Door].ai[door].inRange = false; }
+	void SavePrevious();
+	void Interpolate(float alpha) { this->alpha = alpha; }
+	void Draw(Render &render, glm::vec4 cameraRect, EntityArchetype type);
+
+	//walkers then scientists, indices shift when enemies are removed
+	unsigned int EnemyCount() { return tables[Walker].size() + tables[Scientist].size(); }
+	//sorted enemy indices from the last Wake, only valid until enemies are removed
+	const std::vector<unsigned int>& AwakeEnemies() { return awakeEnemies; }
+	bool EnemyActive(unsigned int i);
+	glm::vec4 EnemyHitBox(unsigned int i);
+	glm::vec2 EnemyMid(unsigned int i);
+	void HurtEnemy(unsigned int i, glm::vec2 hurtLoc);
+	bool EnemyShoot(unsigned int i, const TileOccupancy &occupancy, glm::vec2 target);
+	void RemoveDeadEnemies();
+	void RemoveActiveEnemies();
+
+private:
+	EntityTable& enemyTable(unsigned int &i);
+	void bucketRooms(const gh::RoomGraph &rooms);
+	void gatherAwake(const gh::RoomGraph &rooms, int room);
+	void scheduleDue(glm::vec4 nearArea);
+	void updateWalkers(unsigned int begin, unsigned int end, gh::SpatialGrid &colliders, const TileOccupancy &walls, glm::vec4 currentRoom, const FlowField &flow);
+	void updateScientists(unsigned int begin, unsigned int end, gh::SpatialGrid &colliders, const TileOccupancy &walls, glm::vec4 currentRoom);
+	void updateDoors(unsigned int begin, unsigned int end, float dt);
+	void move(EntityTable &t, unsigned int i, float dt, gh::SpatialGrid &colliders, const TileOccupancy &walls);
+	void play(EntityTable &t, unsigned int i, float dt, bool once);
+
+	std::array<EntityTable, ARCHETYPE_COUNT> tables;
+	gh::Random rand;
+	//enemy indices per room for each enemy archetype, rebuilt when an enemy spawns, dies or changes room
+	std::array<std::vector<std::vector<unsigned int>>, ENEMY_ARCHETYPE_COUNT> roomBuckets;
+	bool bucketsDirty = true;
+	std::array<std::vector<unsigned int>, ENEMY_ARCHETYPE_COUNT> awake;
+	std::vector<unsigned int> awakeEnemies;
+	//awake enemies updating this tick
+	std::array<std::vector<unsigned int>, ENEMY_ARCHETYPE_COUNT> due;
+	unsigned int ticks = 0;
+	unsigned int sightChecks = 0;
+	//1 opened, -1 closed this update
+	std::vector<signed char> doorEvents;
+	//entities to remove, kept between ticks so it isn't allocated again
+	std::vector<unsigned char> removed;
+	float alpha = 1.0f;
+
+	float pushDelay = 150;
+	float invDelay = 300;
+	float pushFactor = 10;
+	float baseShootDelay = 3000;
+};
+
+#endif
@@ -0,0 +1,116 @@
+#include "flowField.h"
+
+static const unsigned short FLOW_UNREACHED = 0xFFFF;
+//orthogonal first so ties go straight
+static const int DIR_X[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int DIR_Y[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+FlowField::FlowField(const TileOccupancy &occupancy)
+{
+	width = occupancy.getWidth();
+	height = occupancy.getHeight();
+	tileSize = occupancy.getTileSize();
+	originX = occupancy.getOriginX();
+	originY = occupancy.getOriginY();
+	blocked.resize(width * height);
+	for(unsigned int y = 0; y < height; y++)
+		for(unsigned int x = 0; x < width; x++)
+			blocked[y * width + x] = occupancy.Solid(x + originX, y + originY) || occupancy.Gap(x + originX, y + originY);
+	steps.assign(width * height, FLOW_UNREACHED);
+	direction.assign(width * height, -1);
+}
+
+void FlowField::Target(glm::vec2 target)
+{
+	this->target = target;
+	int tile = tileIndex(target);
+	if(tile == targetTile)
+		return;
+	targetTile = tile;
+	search();
+}
+
+glm::vec2 FlowField::Sample(glm::vec2 position) const
+{
+	int tile = tileIndex(position);
+	if(tile == -1 || steps[tile] == FLOW_UNREACHED)
+		return glm::vec2(0);
+	if(tile == targetTile)
+	{
+		glm::vec2 toTarget = target - position;
+		return toTarget == glm::vec2(0) ? toTarget : glm::normalize(toTarget);
+	}
+	int d = direction[tile];
+	if(d < 0)
+		return glm::vec2(0);
+	return glm::normalize(glm::vec2(DIR_X[d], DIR_Y[d]));
+}
+
+int FlowField::tileIndex(glm::vec2 position) const
+{
+	int x = (int)std::floor(position.x / tileSize.x) - originX;
+	int y = (int)std::floor(position.y / tileSize.y) - originY;
+	if(x < 0 || y < 0 || x >= (int)width || y >= (int)height)
+		return -1;
+	return y * width + x;
+}
+
+void FlowField::search()
+{
+	for(auto tile: reached)
+	{
+		steps[tile] = FLOW_UNREACHED;
+		direction[tile] = -1;
+	}
+	reached.clear();
+	if(targetTile == -1)
+		return;
+
+	//breadth first over orthogonal steps, reached doubles as the queue
+	steps[targetTile] = 0;
+	reached.push_back(targetTile);
+	for(size_t next = 0; next < reached.size(); next++)
+	{
+		unsigned int tile = reached[next];
+		if(steps[tile] >= FLOW_FIELD_RADIUS)
+			continue;
+		int x = tile % width;
+		int y = tile / width;
+		for(int d = 0; d < 4; d++)
+		{
+			int nx = x + DIR_X[d];
+			int ny = y + DIR_Y[d];
+			if(nx < 0 || ny < 0 || nx >= (int)width || ny >= (int)height)
+				continue;
+			unsigned int n = ny * width + nx;
+			if(blocked[n] || steps[n] != FLOW_UNREACHED)
+				continue;
+			steps[n] = steps[tile] + 1;
+			reached.push_back(n);
+		}
+	}
+
+	//each tile points at its lowest neighbour, diagonals only when both sides are open
+	for(auto tile: reached)
+	{
+		int x = tile % width;
+		int y = tile / width;
+		unsigned short best = steps[tile];
+		for(int d = 0; d < 8; d++)
+		{
+			int nx = x + DIR_X[d];
+			int ny = y + DIR_Y[d];
+			if(nx < 0 || ny < 0 || nx >= (int)width || ny >= (int)height)
+				continue;
+			if(d >= 4 && (blocked[y * width + nx] || blocked[ny * width + x]))
+				continue;
+			unsigned int n = ny * width + nx;
+			//a diagonal only wins when it saves a step over going straight
+			if(steps[n] < best)
+			{
+				best = steps[n];
+				direction[tile] = d;
+			}
+		}
+	}
+}
@@ -0,0 +1,47 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cmath>
+
+#include "tileOccupancy.h"
+
+//furthest path from the target searched, in tiles
+const unsigned int FLOW_FIELD_RADIUS = 40;
+
+//shortest walkable paths to one target over the map's solid and gap tiles.
+//each tile stores the step toward the target, so any number of enemies can sample it
+class FlowField
+{
+public:
+	FlowField() {}
+	FlowField(const TileOccupancy &occupancy);
+
+	//searches again only when the target moves to another tile, clearing just the tiles the last search reached
+	void Target(glm::vec2 target);
+	//unit direction toward the target, zero when out of range or on a blocked tile
+	glm::vec2 Sample(glm::vec2 position) const;
+
+private:
+	int tileIndex(glm::vec2 position) const;
+	void search();
+
+	unsigned int width = 0;
+	unsigned int height = 0;
+	//first tile of the occupancy it was built from
+	int originX = 0;
+	int originY = 0;
+	glm::vec2 tileSize = glm::vec2(1);
+	std::vector<unsigned char> blocked;
+	//steps from the target tile, FLOW_UNREACHED outside the last search
+	std::vector<unsigned short> steps;
+	//index into the direction table, -1 for none
+	std::vector<signed char> direction;
+	std::vector<unsigned int> reached;
+
+	int targetTile = -1;
+	glm::vec2 target = glm::vec2(0);
+};
+
+#endif
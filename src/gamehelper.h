@@ -5,7 +5,10 @@
 #include <string>
 #include <stdio.h>
 #include <random>
+#include <atomic>
 #include <ctime>
+#include <limits>
+#include <algorithm>
 
 namespace gh
 {
@@ -17,6 +20,62 @@ namespace gh
 				a.y + a.w > b.y;
 	}
 
+	//the area rect covers moving by delta
+	static glm::vec4 sweptRect(glm::vec4 rect, glm::vec2 delta)
+	{
+		return glm::vec4(std::min(rect.x, rect.x + delta.x), std::min(rect.y, rect.y + delta.y),
+						rect.z + std::abs(delta.x), rect.w + std::abs(delta.y));
+	}
+
+	struct SweepHit
+	{
+		float time = 1;
+		glm::vec2 normal = glm::vec2(0);
+		glm::vec4 rect = glm::vec4(0);
+	};
+
+	//time in [0, 1] along delta that rect a first touches rect b, false if it doesn't or a starts inside b,
+	//which SpatialGrid's moves push out of before sweeping
+	static bool sweep(glm::vec4 a, glm::vec2 delta, glm::vec4 b, float &time, glm::vec2 &normal)
+	{
+		const float inf = std::numeric_limits<float>::infinity();
+		float entryX = -inf, exitX = inf, entryY = -inf, exitY = inf;
+		if(delta.x > 0)
+		{
+			entryX = (b.x - (a.x + a.z)) / delta.x;
+			exitX = (b.x + b.z - a.x) / delta.x;
+		}
+		else if(delta.x < 0)
+		{
+			entryX = (b.x + b.z - a.x) / delta.x;
+			exitX = (b.x - (a.x + a.z)) / delta.x;
+		}
+		else if(!(a.x < b.x + b.z && a.x + a.z > b.x))
+			return false;
+		if(delta.y > 0)
+		{
+			entryY = (b.y - (a.y + a.w)) / delta.y;
+			exitY = (b.y + b.w - a.y) / delta.y;
+		}
+		else if(delta.y < 0)
+		{
+			entryY = (b.y + b.w - a.y) / delta.y;
+			exitY = (b.y - (a.y + a.w)) / delta.y;
+		}
+		else if(!(a.y < b.y + b.w && a.y + a.w > b.y))
+			return false;
+		float entry = std::max(entryX, entryY);
+		float exit = std::min(exitX, exitY);
+		if(entry >= exit || entry < 0 || entry > 1)
+			return false;
+		time = entry;
+		if(entryX >= entryY)
+			normal = glm::vec2(delta.x > 0 ? -1 : 1, 0);
+		else
+			normal = glm::vec2(0, delta.y > 0 ? -1 : 1);
+		return true;
+	}
+
 	static bool aInB(glm::vec4 a, glm::vec4 b)
 	{
 		return a.x > b.x && a.x < b.x + b.z &&
@@ -37,16 +96,29 @@ namespace gh
     } 
 	}  
 
+//every generator is seeded from one run seed and the order it was made in,
+//so setting the run seed before anything is made gives repeatable runs
 class Random
 {
 public:
 	Random()
 	{
-		randomGen = std::mt19937(time(0));
+		std::seed_seq seq = { runSeed(), generatorCount()++ };
+		randomGen = std::mt19937(seq);
 		posReal = std::uniform_real_distribution<float>(0, 1);
 		real = std::uniform_real_distribution<float>(-1, 1);
 	}
 
+	static void SetSeed(unsigned int seed)
+	{
+		runSeed() = seed;
+		generatorCount() = 0;
+	}
+	static unsigned int Seed()
+	{
+		return runSeed();
+	}
+
 	float Real()
 	{
 		return real(randomGen);
@@ -56,6 +128,17 @@ public:
 		return posReal(randomGen);
 	}
 private:
+	static unsigned int& runSeed()
+	{
+		static unsigned int seed = (unsigned int)time(0);
+		return seed;
+	}
+	static std::atomic<unsigned int>& generatorCount()
+	{
+		static std::atomic<unsigned int> count(0);
+		return count;
+	}
+
 	std::mt19937 randomGen;
 	std::uniform_real_distribution<float> posReal;
 	std::uniform_real_distribution<float> real;
@@ -0,0 +1,13 @@
+#ifndef GLFW_KEYS_H
+#define GLFW_KEYS_H
+
+//the glfw key codes the simulation reads, so recorded input means the same thing without glfw
+#define GLFW_KEY_SPACE 32
+#define GLFW_KEY_COMMA 44
+#define GLFW_KEY_A 65
+#define GLFW_KEY_D 68
+#define GLFW_KEY_S 83
+#define GLFW_KEY_W 87
+#define GLFW_KEY_LEFT_SHIFT 340
+
+#endif
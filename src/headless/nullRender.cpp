@@ -0,0 +1,24 @@
+#include "nullRender.h"
+
+#include <stdexcept>
+
+Resource::Texture Render::LoadTexture(std::string filepath)
+{
+	//only the header is read, the game needs sizes for frames and tiles but never the pixels
+	int width, height, channels;
+	if(!stbi_info(filepath.c_str(), &width, &height, &channels))
+		throw std::runtime_error("failed to read texture header at " + filepath);
+	return Resource::Texture(textureCount++, glm::vec2(width, height), filepath);
+}
+
+Resource::Texture Render::LoadTexture(unsigned char* data, int width, int height, int nrChannels)
+{
+	delete[] data;
+	return Resource::Texture(textureCount++, glm::vec2(width, height), "NULL");
+}
+
+void Render::endResourceLoad()
+{
+	if(textureCount > (unsigned int)Resource::MAX_TEXTURES_SUPPORTED)
+		throw std::runtime_error("not enough storage for textures");
+}
@@ -0,0 +1,100 @@
+#ifndef NULL_RENDER_H
+#define NULL_RENDER_H
+
+#ifndef GLM_FORCE_DEPTH_ZERO_TO_ONE
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#endif
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <string>
+#include <vector>
+#include <atomic>
+
+#include "glfwKeys.h"
+#include "../vulkan-render/stb_image.h"
+#include "../vulkan-render/rect_helper.h"
+
+namespace Resource
+{
+
+//same limit as the vulkan renderer, so running headless fails where the game would
+const int MAX_TEXTURES_SUPPORTED = 200;
+//the real font loads a texture for each printable glyph but the space
+const unsigned int FONT_GLYPH_TEXTURES = 93;
+
+enum class TextureType
+{
+	Diffuse,
+	Specular,
+	Ambient,
+	Shadow
+};
+
+struct Texture
+{
+	Texture()
+	{
+		path = "";
+		ID = 0;
+		dim = glm::vec2(1, 1);
+		type = TextureType::Diffuse;
+	}
+	Texture(unsigned int ID, glm::vec2 dimentions, std::string path)
+	{
+		this->path = path;
+		this->ID = ID;
+		this->dim = dimentions;
+		type = TextureType::Diffuse;
+	}
+	std::string path;
+	unsigned int ID = 0;
+	glm::vec2 dim = glm::vec2(0, 0);
+	TextureType type;
+};
+
+class Font {};
+
+}
+
+//the game calls the matrix helpers through vkhelper, they are the renderer's own
+struct vkhelper : public recthelper {};
+
+//stands in for the vulkan renderer without a window or gpu. textures only keep their size,
+//read from the image header, and drawing does nothing
+class Render
+{
+public:
+	Render(glm::vec2 target) {}
+	void set2DViewMatrix(glm::mat4 view) {}
+	Resource::Texture LoadTexture(std::string filepath);
+	//takes the data like the real renderer does
+	Resource::Texture LoadTexture(unsigned char* data, int width, int height, int nrChannels);
+	Resource::Font* LoadFont(std::string filepath)
+	{
+		textureCount += Resource::FONT_GLYPH_TEXTURES;
+		return &font;
+	}
+	void endResourceLoad();
+	unsigned int TexturesLeft()
+	{
+		return textureCount < (unsigned int)Resource::MAX_TEXTURES_SUPPORTED ? Resource::MAX_TEXTURES_SUPPORTED - textureCount : 0;
+	}
+	void begin2DDraw() {}
+	void endDraw(std::atomic<bool>& submit) { submit = true; }
+	void DrawQuad(const Resource::Texture& texID, glm::mat4 modelMatrix, glm::vec4 colour) {}
+	void DrawQuad(const Resource::Texture& texID, glm::mat4 modelMatrix, glm::vec4 colour, glm::vec4 texOffset) {}
+	void DrawQuad(const Resource::Texture& texID, glm::mat4 modelMatrix, glm::vec4 colour, glm::vec4 texOffset, bool lighting) {}
+	void DrawString(Resource::Font* font, std::string text, glm::vec2 position, float size, float rotate, glm::vec4 colour) {}
+	//only lays out message lines, which the simulation never reads
+	float MeasureString(Resource::Font* font, std::string text, float size) { return text.size() * size; }
+	void setLights(std::vector<glm::vec2> &lights) {}
+	void setLightingProps(float linear, float quadratic) {}
+
+	bool framebufferResized = false;
+private:
+	unsigned int textureCount = 0;
+	Resource::Font font;
+};
+
+#endif
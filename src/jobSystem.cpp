@@ -0,0 +1,230 @@
+#include "jobSystem.h"
+
+#include <iostream>
+
+namespace gh
+{
+
+//which system and queue the current thread works for
+static thread_local JobSystem *currentSystem = nullptr;
+static thread_local unsigned int currentQueue = 0;
+
+JobSystem::JobSystem(unsigned int workers) : queued(0), quit(false)
+{
+	for(unsigned int i = 0; i < workers + 1; i++)
+		queues.push_back(std::unique_ptr<Queue>(new Queue()));
+	for(unsigned int i = 0; i < workers; i++)
+		this->workers.push_back(std::thread(&JobSystem::work, this, i + 1));
+}
+
+JobSystem::~JobSystem()
+{
+	quit = true;
+	{
+		std::lock_guard<std::mutex> l(sleepLock);
+	}
+	wake.notify_all();
+	for(auto &w: workers)
+		w.join();
+}
+
+JobSystem& JobSystem::Get()
+{
+	//the thread waiting on jobs helps, so one less worker than cores
+	static unsigned int cores = std::thread::hardware_concurrency();
+	static JobSystem system(cores > 1 ? cores - 1 : 1);
+	return system;
+}
+
+void JobSystem::Run(Job job, JobCounter *counter, JobCounter *dependency)
+{
+	if(counter != nullptr)
+		counter->pending++;
+	if(dependency != nullptr)
+	{
+		std::lock_guard<std::mutex> l(dependency->lock);
+		if(dependency->pending.load() > 0)
+		{
+			dependency->continuations.push_back({job, counter});
+			return;
+		}
+	}
+	push({job, counter});
+}
+
+void JobSystem::Wait(JobCounter &counter)
+{
+	unsigned int queue = currentSystem == this ? currentQueue : 0;
+	while(!counter.Done())
+		if(!tryRun(queue))
+			std::this_thread::yield();
+	//the last job may still hold the lock after the count reaches zero
+	std::exception_ptr error;
+	{
+		std::lock_guard<std::mutex> l(counter.lock);
+		error = counter.error;
+		counter.error = nullptr;
+	}
+	if(error)
+		std::rethrow_exception(error);
+}
+
+void JobSystem::push(Task task)
+{
+	Queue &q = *queues[currentSystem == this ? currentQueue : 0];
+	{
+		std::lock_guard<std::mutex> l(q.lock);
+		q.tasks.push_back(task);
+	}
+	queued++;
+	{
+		std::lock_guard<std::mutex> l(sleepLock);
+	}
+	wake.notify_one();
+}
+
+bool JobSystem::tryRun(unsigned int queue)
+{
+	Task task;
+	if(!pop(queue, task))
+		return false;
+	try
+	{
+		task.job();
+	}
+	catch(...)
+	{
+		if(task.counter != nullptr)
+		{
+			std::lock_guard<std::mutex> l(task.counter->lock);
+			if(!task.counter->error)
+				task.counter->error = std::current_exception();
+		}
+		else
+			std::cout << "job without a counter threw an exception" << std::endl;
+	}
+	finish(task.counter);
+	return true;
+}
+
+//newest from our own deque, otherwise steal the oldest from the next deque with work
+bool JobSystem::pop(unsigned int queue, Task &task)
+{
+	for(unsigned int i = 0; i < queues.size(); i++)
+	{
+		bool own = i == 0;
+		Queue &q = *queues[(queue + i) % queues.size()];
+		std::lock_guard<std::mutex> l(q.lock);
+		if(q.tasks.size() == 0)
+			continue;
+		if(own)
+		{
+			task = q.tasks.back();
+			q.tasks.pop_back();
+		}
+		else
+		{
+			task = q.tasks.front();
+			q.tasks.pop_front();
+		}
+		queued--;
+		return true;
+	}
+	return false;
+}
+
+void JobSystem::finish(JobCounter *counter)
+{
+	if(counter == nullptr)
+		return;
+	std::vector<JobCounter::Waiting> ready;
+	{
+		std::lock_guard<std::mutex> l(counter->lock);
+		if(--counter->pending == 0)
+			ready.swap(counter->continuations);
+	}
+	for(auto &w: ready)
+		push({w.job, w.counter});
+}
+
+void JobSystem::work(unsigned int queue)
+{
+	currentSystem = this;
+	currentQueue = queue;
+	while(!quit)
+	{
+		if(tryRun(queue))
+			continue;
+		std::unique_lock<std::mutex> l(sleepLock);
+		wake.wait(l, [this] { return queued.load() > 0 || quit.load(); });
+	}
+}
+
+SubmitThread::SubmitThread()
+{
+	thread = std::thread(&SubmitThread::work, this);
+}
+
+SubmitThread::~SubmitThread()
+{
+	{
+		std::unique_lock<std::mutex> l(lock);
+		changed.wait(l, [this] { return !pending; });
+		quit = true;
+	}
+	changed.notify_all();
+	thread.join();
+}
+
+void SubmitThread::Run(Job job)
+{
+	Wait();
+	{
+		std::lock_guard<std::mutex> l(lock);
+		this->job = job;
+		pending = true;
+	}
+	changed.notify_all();
+}
+
+void SubmitThread::Wait()
+{
+	std::exception_ptr error;
+	{
+		std::unique_lock<std::mutex> l(lock);
+		changed.wait(l, [this] { return !pending; });
+		error = this->error;
+		this->error = nullptr;
+	}
+	if(error)
+		std::rethrow_exception(error);
+}
+
+void SubmitThread::work()
+{
+	std::unique_lock<std::mutex> l(lock);
+	while(true)
+	{
+		changed.wait(l, [this] { return pending || quit; });
+		if(!pending)
+			return;
+		Job next = job;
+		l.unlock();
+		std::exception_ptr thrown;
+		try
+		{
+			next();
+		}
+		catch(...)
+		{
+			thrown = std::current_exception();
+		}
+		l.lock();
+		error = thrown;
+		pending = false;
+		job = nullptr;
+		changed.notify_all();
+	}
+}
+
+} //namespace end
@@ -0,0 +1,113 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <functional>
+#include <exception>
+#include <memory>
+
+namespace gh
+{
+
+typedef std::function<void()> Job;
+
+//counts unfinished jobs, jobs can be made to wait on a counter reaching zero.
+//the first exception thrown by a job is kept and rethrown by JobSystem::Wait
+class JobCounter
+{
+public:
+	JobCounter() : pending(0) {}
+	bool Done() { return pending.load() == 0; }
+
+private:
+	friend class JobSystem;
+	struct Waiting
+	{
+		Job job;
+		JobCounter *counter;
+	};
+
+	std::atomic<int> pending;
+	std::mutex lock;
+	std::vector<Waiting> continuations;
+	std::exception_ptr error;
+};
+
+//persistent worker threads, each with its own deque. workers pop their newest job
+//and steal the oldest from others when empty. Threads that aren't workers push to a shared deque
+class JobSystem
+{
+public:
+	JobSystem(unsigned int workers);
+	~JobSystem();
+	//shared by every subsystem, started on first use
+	static JobSystem& Get();
+
+	//counter is optional, the job only starts once dependency (if any) is done
+	void Run(Job job, JobCounter *counter, JobCounter *dependency = nullptr);
+	//runs other jobs while waiting instead of blocking
+	void Wait(JobCounter &counter);
+	//worker threads plus the thread that waits
+	unsigned int ThreadCount() { return (unsigned int)workers.size() + 1; }
+
+private:
+	struct Task
+	{
+		Job job;
+		JobCounter *counter;
+	};
+	struct Queue
+	{
+		std::mutex lock;
+		std::deque<Task> tasks;
+	};
+
+	void push(Task task);
+	bool tryRun(unsigned int queue);
+	bool pop(unsigned int queue, Task &task);
+	void finish(JobCounter *counter);
+	void work(unsigned int queue);
+
+	std::vector<std::thread> workers;
+	//0 is shared by non worker threads
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::atomic<int> queued;
+	std::atomic<bool> quit;
+	std::mutex sleepLock;
+	std::condition_variable wake;
+};
+
+//one persistent thread for long blocking work like presenting a frame, kept off the job queues
+//so a thread helping in JobSystem::Wait can never pick it up. Runs a single job at a time
+class SubmitThread
+{
+public:
+	SubmitThread();
+	~SubmitThread();
+	//waits for the last job first
+	void Run(Job job);
+	//blocks until the last job is done, rethrows if it threw
+	void Wait();
+
+private:
+	SubmitThread(const SubmitThread&);
+	SubmitThread& operator=(const SubmitThread&);
+	void work();
+
+	std::thread thread;
+	std::mutex lock;
+	std::condition_variable changed;
+	Job job;
+	bool pending = false;
+	bool quit = false;
+	std::exception_ptr error;
+};
+
+} //namespace end
+
+#endif
@@ -1,9 +1,11 @@
 #include "app.h"
+#include "replay.h"
 #include <stdexcept>
 #include <iostream>
+#include <string>
 
 
-int main()
+int main(int argc, char** argv)
 {
 
 	try
@@ -11,7 +13,42 @@ int main()
 		#ifndef NDEBUG
 		std::cout << "In debug mode" << std::endl;
 		#endif
-		App* app = new App();
+		//--record <file> saves this run's input, --replay <file> plays a saved run back,
+		//--ticks <count> stops after that many ticks, --stress <count> adds that many entities
+		//around the player and --map <name> picks the starting map
+		gh::Replay replay;
+		RunOptions options;
+		std::string usage = "usage: " + std::string(argv[0]) +
+			" [--record <file> | --replay <file>] [--ticks <count>] [--stress <count>] [--map forgotten|remebered]";
+		for(int i = 1; i < argc; i += 2)
+		{
+			std::string arg = argv[i];
+			if(i + 1 >= argc)
+				throw std::runtime_error(usage);
+			if(arg == "--record" && replay.Mode() == gh::ReplayMode::Off)
+				replay.Record(argv[i + 1]);
+			else if(arg == "--replay" && replay.Mode() == gh::ReplayMode::Off)
+				replay.Play(argv[i + 1]);
+			else if(arg == "--ticks")
+				options.tickLimit = std::stoul(argv[i + 1]);
+			else if(arg == "--stress")
+				options.stressCount = std::stoul(argv[i + 1]);
+			else if(arg == "--map")
+				options.startMap = argv[i + 1];
+			else
+				throw std::runtime_error(usage);
+		}
+		if(replay.Mode() != gh::ReplayMode::Off)
+			options.replay = &replay;
+		//stress runs are compared against each other, so they use the same seed unless a replay set one
+		if(options.stressCount > 0 && replay.Mode() == gh::ReplayMode::Off)
+			gh::Random::SetSeed(STRESS_SEED);
+		#ifdef HEADLESS
+		//with nothing to stop it a headless run would never end
+		if(options.tickLimit == 0 && replay.Mode() != gh::ReplayMode::Play)
+			options.tickLimit = HEADLESS_DEFAULT_TICKS;
+		#endif
+		App* app = new App(options);
 		app->run();
 		delete app;
 		app = nullptr;
@@ -2,38 +2,35 @@
 
 Map::Map(std::string filename, Render &render)
 {
-	map = tiled::Map(filename);
-
-	tileMats.resize(map.width * map.height);
-	toDraw.resize(map.width * map.height);
-	tileRects.resize(map.width * map.height);
-	int index = 0;
-	for(unsigned int y = 0; y < map.height; y++)
-		for(unsigned int x = 0; x < map.width; x++)
-		{
-			tileRects[index] = glm::vec4(x * map.tileWidth, y * map.tileHeight, map.tileWidth, map.tileHeight);
-			tileMats[index] = vkhelper::calcMatFromRect(tileRects[index], 0);
-			toDraw[index++] = false;
-		}
-		
-
-	for(const auto &layer: map.layers)
+	std::vector<bool> solid;
+	std::vector<bool> gap;
+	std::string compiled = CompiledPath(filename);
+	if(!loadCompiled(compiled, solid, gap))
 	{
-		if(layer.props.collidable || layer.props.gap)
+		loadTiled(filename, solid, gap);
+		//infinite maps stream their chunks out of the compiled map, the game never writes one itself
+		if(map.infinite)
+			throw std::runtime_error("infinite map at " + filename + " is streamed from its compiled map, run MapCompiler on it to write "
+					+ compiled);
+	}
+
+	chunksX = (map.width + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE;
+	chunksY = (map.height + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE;
+	chunks.resize(chunksX * chunksY);
+	for(unsigned int cy = 0; cy < chunksY; cy++)
+		for(unsigned int cx = 0; cx < chunksX; cx++)
 		{
-			//TODO: make colliders more efficient by merging rects 
-			size_t i = 0;
-			for(unsigned int y = 0; y < map.height; y++)
-				for(unsigned int x = 0; x < map.width; x++)
-				{
-					if(layer.data[i] != 0 && layer.props.collidable)
-						colliders.push_back(glm::vec4(x * map.tileWidth, y * map.tileHeight, map.tileWidth, map.tileHeight));
-					if(layer.data[i] != 0 && layer.props.gap)
-						gaps.push_back(glm::vec4(x * map.tileWidth, y * map.tileHeight, map.tileWidth, map.tileHeight/3));
-					i++;
-				}
+			MapChunk &chunk = chunks[cy * chunksX + cx];
+			unsigned int w = std::min(MAP_CHUNK_SIZE, map.width - cx * MAP_CHUNK_SIZE);
+			unsigned int h = std::min(MAP_CHUNK_SIZE, map.height - cy * MAP_CHUNK_SIZE);
+			chunk.rect = glm::vec4(cx * MAP_CHUNK_SIZE * map.tileWidth, cy * MAP_CHUNK_SIZE * map.tileHeight,
+						w * map.tileWidth, h * map.tileHeight);
+			//streamed chunks have theirs from the compiled map
+			if(stream != nullptr)
+				continue;
+			chunk.layerEmpty.resize(map.layers.size());
+			updateChunkLayers(chunk, cx, cy);
 		}
-	}
 
 	tiles.resize(map.totalTiles + 1);
 	tiles[0] = Tile();
@@ -52,16 +49,99 @@ Map::Map(std::string filename, Render &render)
 			}
 	}
 
+	//textures can't be made after loading, so streamed chunks are drawn tile by tile as they come in
+	if(stream == nullptr)
+		Bake(render);
+
+	mapRect = glm::vec4(0, 0, map.width * map.tileWidth, map.height * map.tileHeight);
+	for(unsigned int i = 0; i < checkpoints.size(); i++)
+		triggers.Add(checkpoints[i], TriggerType::Checkpoint, i);
+	for(unsigned int i = 0; i < items.size(); i++)
+		triggers.Add(items[i], TriggerType::Item, i);
+	for(unsigned int i = 0; i < messageAreas.size(); i++)
+		triggers.Add(messageAreas[i].rect, TriggerType::Message, i);
+	//covers every player middle within door range, so the player sprite touches it whenever the door could open
+	for(unsigned int i = 0; i < doors.size(); i++)
+		triggers.Add(glm::vec4(doors[i].x - DOOR_TRIGGER_RANGE, doors[i].y - DOOR_TRIGGER_RANGE,
+						DOOR_TRIGGER_RANGE * 2, DOOR_TRIGGER_RANGE * 2), TriggerType::Door, i);
+	if(reactorRoom != glm::vec4(0))
+		triggers.Add(reactorRoom, TriggerType::ReactorRoom, 0);
+	if(reactorTP != glm::vec4(0))
+		triggers.Add(reactorTP, TriggerType::ReactorTP, 0);
+	//a streamed map's grid only covers its triggers, the map could be far bigger than they are
+	triggers.Build(stream != nullptr ? triggers.Bounds() : mapRect);
+	if(stream == nullptr)
+		occupancy = TileOccupancy(map.width, map.height, glm::vec2(map.tileWidth, map.tileHeight), solid, gap);
+	else
+		//until the game makes the area around the player active
+		UpdateActive(glm::vec4(playerSpawn.x, playerSpawn.y, 0, 0));
+}
+
+//parses the tmx and its tilesets, returns every file read so the compiled map can tell when it is stale
+std::vector<std::string> Map::loadTiled(std::string filename, std::vector<bool> &solid, std::vector<bool> &gap)
+{
+	map = tiled::Map(filename);
+	std::vector<std::string> sources;
+	sources.push_back(filename);
+	for(const auto &tileset: map.tilesets)
+		sources.push_back(tileset.source);
+
+	solid.assign(map.width * map.height, false);
+	gap.assign(map.width * map.height, false);
+	size_t solidCount = 0;
+	size_t gapCount = 0;
+	auto markTile = [&](const tiled::Layer &layer, size_t i) {
+		if(layer.props.collidable)
+		{
+			solid[i] = true;
+			solidCount++;
+		}
+		if(layer.props.gap)
+		{
+			gap[i] = true;
+			gapCount++;
+		}
+	};
+	for(const auto &layer: map.layers)
+	{
+		if(layer.props.collidable || layer.props.gap)
+		{
+			for(size_t i = 0; i < layer.data.size(); i++)
+			{
+				if(layer.data[i] != 0)
+					markTile(layer, i);
+			}
+			//infinite maps only have chunks
+			for(const auto &chunk: layer.chunks)
+				for(unsigned int y = 0; y < chunk.height; y++)
+					for(unsigned int x = 0; x < chunk.width; x++)
+						if(chunk.data[y * chunk.width + x] != 0)
+							markTile(layer, (size_t)(chunk.y + y) * map.width + chunk.x + x);
+		}
+	}
+	colliders = mergeTileRects(solid, map.tileHeight, true);
+	//gaps only cover the top third of a tile, so they can only merge along a row
+	gaps = mergeTileRects(gap, map.tileHeight/3, false);
+	std::cout << "map " << filename << ": merged " << solidCount << " collider tiles into " << colliders.size()
+		<< " rects, " << gapCount << " gap tiles into " << gaps.size() << " rects" << std::endl;
+
 	for(const auto &objGroup: map.objectGroups)
 	{
 		for(const auto &obj: objGroup.objs)
 		{
 			if(obj.props.collidable || objGroup.props.collidable)
+			{
 				colliders.push_back(glm::vec4(obj.x, obj.y, obj.w, obj.h));
+				markObjectTiles(solid, colliders.back());
+			}
 			if(obj.props.camera || objGroup.props.camera)
 				cameraRects.push_back(glm::vec4(obj.x, obj.y, obj.w, obj.h));
 			if(obj.props.message != "")
+			{
 				messageAreas.push_back(MapMessage(glm::vec4(obj.x, obj.y, obj.w, obj.h), obj.props.message));
+				if(std::find(sources.begin(), sources.end(), obj.props.message) == sources.end())
+					sources.push_back(obj.props.message);
+			}
 			if(obj.props.playerSpawn)
 				playerSpawn = glm::vec2(obj.x, obj.y);
 			if(obj.props.enemySpawn || objGroup.props.enemySpawn)
@@ -83,20 +163,114 @@ Map::Map(std::string filename, Render &render)
 		}
 	}
 
-	mapRect = glm::vec4(0, 0, map.width * map.tileWidth, map.height * map.tileHeight);
+	return sources;
+}
+
+static unsigned int clampTile(float tile, unsigned int tileCount)
+{
+	if(tile < 0)
+		return 0;
+	if(tile > tileCount)
+		return tileCount;
+	return (unsigned int)tile;
 }
 
 void Map::Update(glm::vec4 cameraRect)
 {
-	for(unsigned int i = 0; i < toDraw.size(); i++)
+	//same tiles as testing gh::colliding(cameraRect, tileRect) against every tile
+	visibleStartX = clampTile(std::floor(cameraRect.x / map.tileWidth), map.width);
+	visibleStartY = clampTile(std::floor(cameraRect.y / map.tileHeight), map.height);
+	visibleEndX = clampTile(std::ceil((cameraRect.x + cameraRect.z) / map.tileWidth), map.width);
+	visibleEndY = clampTile(std::ceil((cameraRect.y + cameraRect.w) / map.tileHeight), map.height);
+	if(stream != nullptr)
 	{
-		if(gh::colliding(cameraRect, tileRects[i]))
-			toDraw[i] = true;
-		else
-			toDraw[i] = false;
+		//chunks a little way off the screen load ahead of the camera, anything further is dropped
+		unsigned int startX = 0, startY = 0, endX = 0, endY = 0;
+		if(visibleStartX < visibleEndX && visibleStartY < visibleEndY)
+		{
+			startX = visibleStartX / MAP_CHUNK_SIZE - std::min(visibleStartX / MAP_CHUNK_SIZE, MAP_STREAM_RADIUS);
+			startY = visibleStartY / MAP_CHUNK_SIZE - std::min(visibleStartY / MAP_CHUNK_SIZE, MAP_STREAM_RADIUS);
+			endX = std::min((visibleEndX - 1) / MAP_CHUNK_SIZE + 1 + MAP_STREAM_RADIUS, chunksX);
+			endY = std::min((visibleEndY - 1) / MAP_CHUNK_SIZE + 1 + MAP_STREAM_RADIUS, chunksY);
+		}
+		stream->Request(startX, startY, endX, endY);
 	}
 }
 
+bool Map::UpdateActive(glm::vec4 area)
+{
+	if(stream == nullptr)
+		return false;
+	float chunkWidth = MAP_CHUNK_SIZE * map.tileWidth;
+	float chunkHeight = MAP_CHUNK_SIZE * map.tileHeight;
+	unsigned int startX = clampTile(std::floor(area.x / chunkWidth) - MAP_STREAM_RADIUS, chunksX);
+	unsigned int startY = clampTile(std::floor(area.y / chunkHeight) - MAP_STREAM_RADIUS, chunksY);
+	unsigned int endX = clampTile(std::ceil((area.x + area.z) / chunkWidth) + MAP_STREAM_RADIUS, chunksX);
+	unsigned int endY = clampTile(std::ceil((area.y + area.w) / chunkHeight) + MAP_STREAM_RADIUS, chunksY);
+	if(activeSet && startX == activeStartX && startY == activeStartY && endX == activeEndX && endY == activeEndY)
+		return false;
+	activeSet = true;
+	activeStartX = startX;
+	activeStartY = startY;
+	activeEndX = endX;
+	activeEndY = endY;
+
+	colliders.clear();
+	gaps.clear();
+	lights.clear();
+	enemySpawns.clear();
+	scientist.clear();
+	for(unsigned int cy = startY; cy < endY; cy++)
+		for(unsigned int cx = startX; cx < endX; cx++)
+		{
+			unsigned int c = cy * chunksX + cx;
+			const MapChunkObjects &objects = chunkObjects[c];
+			colliders.insert(colliders.end(), objects.colliders.begin(), objects.colliders.end());
+			gaps.insert(gaps.end(), objects.gaps.begin(), objects.gaps.end());
+			lights.insert(lights.end(), objects.lights.begin(), objects.lights.end());
+			if(chunkSpawned[c])
+				continue;
+			chunkSpawned[c] = true;
+			enemySpawns.insert(enemySpawns.end(), objects.enemySpawns.begin(), objects.enemySpawns.end());
+			scientist.insert(scientist.end(), objects.scientists.begin(), objects.scientists.end());
+		}
+
+	//read straight from the mapped blocks, the same for every player whatever has been streamed in for drawing
+	const unsigned int chunkTiles = MAP_CHUNK_SIZE * MAP_CHUNK_SIZE;
+	unsigned int tileX = startX * MAP_CHUNK_SIZE;
+	unsigned int tileY = startY * MAP_CHUNK_SIZE;
+	unsigned int width = std::min(endX * MAP_CHUNK_SIZE, map.width) - std::min(tileX, map.width);
+	unsigned int height = std::min(endY * MAP_CHUNK_SIZE, map.height) - std::min(tileY, map.height);
+	std::vector<bool> solid(width * height, false);
+	std::vector<bool> gap(width * height, false);
+	for(unsigned int cy = startY; cy < endY; cy++)
+		for(unsigned int cx = startX; cx < endX; cx++)
+		{
+			const unsigned char* block = stream->Block(cy * chunksX + cx);
+			if(block == nullptr)
+				continue;
+			const unsigned char* occupied = block + map.layers.size() * chunkTiles * sizeof(unsigned int);
+			unsigned int w = std::min(MAP_CHUNK_SIZE, map.width - cx * MAP_CHUNK_SIZE);
+			unsigned int h = std::min(MAP_CHUNK_SIZE, map.height - cy * MAP_CHUNK_SIZE);
+			for(unsigned int y = 0; y < h; y++)
+				for(unsigned int x = 0; x < w; x++)
+				{
+					size_t i = (size_t)(cy * MAP_CHUNK_SIZE + y - tileY) * width + cx * MAP_CHUNK_SIZE + x - tileX;
+					solid[i] = occupied[y * MAP_CHUNK_SIZE + x] != 0;
+					gap[i] = occupied[chunkTiles + y * MAP_CHUNK_SIZE + x] != 0;
+				}
+		}
+	occupancy = TileOccupancy(width, height, glm::vec2(map.tileWidth, map.tileHeight), solid, gap, tileX, tileY);
+	activeRect = glm::vec4(tileX * map.tileWidth, tileY * map.tileHeight, width * map.tileWidth, height * map.tileHeight);
+	return true;
+}
+
+void Map::ResetActive()
+{
+	chunkSpawned.assign(chunkSpawned.size(), false);
+	activeSet = false;
+}
+
 void Map::Draw(Render &render)
 {
 	#ifdef SEE_COLLIDERS
@@ -105,14 +279,209 @@ void Map::Draw(Render &render)
 		render.DrawQuad(Resource::Texture(), vkhelper::getModelMatrix(rect, 0), glm::vec4(1.0f));
 	}
 	#endif
+	if(visibleStartX >= visibleEndX || visibleStartY >= visibleEndY)
+		return;
+	unsigned int chunkStartX = visibleStartX / MAP_CHUNK_SIZE;
+	unsigned int chunkStartY = visibleStartY / MAP_CHUNK_SIZE;
+	unsigned int chunkEndX = (visibleEndX - 1) / MAP_CHUNK_SIZE;
+	unsigned int chunkEndY = (visibleEndY - 1) / MAP_CHUNK_SIZE;
+	for(unsigned int cy = chunkStartY; cy <= chunkEndY; cy++)
+		for(unsigned int cx = chunkStartX; cx <= chunkEndX; cx++)
+		{
+			MapChunk &chunk = chunks[cy * chunksX + cx];
+			if(chunk.empty)
+				continue;
+			if(chunk.baked)
+				render.DrawQuad(chunk.texture, vkhelper::calcMatFromRect(chunk.rect, 0), glm::vec4(1.0f), glm::vec4(0, 0, 1, 1));
+			else
+				drawChunkTiles(render, chunk, cx, cy);
+		}
+}
+
+//greedily grow each unmerged solid cell into the widest then tallest rect of solid cells,
+//for boxes with area this collides exactly where the per tile rects did
+std::vector<glm::vec4> Map::mergeTileRects(std::vector<bool> solid, float rectHeight, bool mergeRows)
+{
+	std::vector<glm::vec4> rects;
+	for(unsigned int y = 0; y < map.height; y++)
+		for(unsigned int x = 0; x < map.width; x++)
+		{
+			if(!solid[y * map.width + x])
+				continue;
+			unsigned int w = 1;
+			while(x + w < map.width && solid[y * map.width + x + w])
+				w++;
+			unsigned int h = 1;
+			bool rowSolid = mergeRows;
+			while(rowSolid && y + h < map.height)
+			{
+				for(unsigned int i = x; i < x + w; i++)
+					if(!solid[(y + h) * map.width + i])
+					{
+						rowSolid = false;
+						break;
+					}
+				if(rowSolid)
+					h++;
+			}
+			for(unsigned int j = y; j < y + h; j++)
+				for(unsigned int i = x; i < x + w; i++)
+					solid[j * map.width + i] = false;
+			rects.push_back(glm::vec4(x * map.tileWidth, y * map.tileHeight,
+						w * map.tileWidth, (h - 1) * map.tileHeight + rectHeight));
+		}
+	return rects;
+}
+
+//object colliders aren't tile aligned, so mark the tiles whose centre they cover
+void Map::markObjectTiles(std::vector<bool> &solid, glm::vec4 rect)
+{
+	float halfW = map.tileWidth / 2.0f;
+	float halfH = map.tileHeight / 2.0f;
+	unsigned int sX = clampTile(std::ceil((rect.x - halfW) / map.tileWidth), map.width);
+	unsigned int sY = clampTile(std::ceil((rect.y - halfH) / map.tileHeight), map.height);
+	unsigned int eX = clampTile(std::ceil((rect.x + rect.z - halfW) / map.tileWidth), map.width);
+	unsigned int eY = clampTile(std::ceil((rect.y + rect.w - halfH) / map.tileHeight), map.height);
+	for(unsigned int y = sY; y < eY; y++)
+		for(unsigned int x = sX; x < eX; x++)
+			solid[y * map.width + x] = true;
+}
+
+void Map::drawChunkTiles(Render &render, MapChunk &chunk, unsigned int cx, unsigned int cy)
+{
+	unsigned int startX = std::max(cx * MAP_CHUNK_SIZE, visibleStartX);
+	unsigned int startY = std::max(cy * MAP_CHUNK_SIZE, visibleStartY);
+	unsigned int endX = std::min((cx + 1) * MAP_CHUNK_SIZE, visibleEndX);
+	unsigned int endY = std::min((cy + 1) * MAP_CHUNK_SIZE, visibleEndY);
+	const unsigned int* streamed = nullptr;
+	if(stream != nullptr)
+	{
+		streamed = stream->Tiles(cy * chunksX + cx);
+		//shows once its load finishes
+		if(streamed == nullptr)
+			return;
+	}
 	for(unsigned int i = map.layers.size(); i > 0; i--)
 	{
-		for(unsigned int j = 0; j < map.layers[i - 1].data.size(); j++)
+		if(chunk.layerEmpty[i - 1])
+			continue;
+		const std::vector<unsigned int> &data = map.layers[i - 1].data;
+		for(unsigned int y = startY; y < endY; y++)
+			for(unsigned int x = startX; x < endX; x++)
+			{
+				unsigned int tile = streamed != nullptr
+					? streamed[((i - 1) * MAP_CHUNK_SIZE + y - cy * MAP_CHUNK_SIZE) * MAP_CHUNK_SIZE + x - cx * MAP_CHUNK_SIZE]
+					: data[y * map.width + x];
+				if(tile != 0)
+					render.DrawQuad(tiles[tile].texture,
+						vkhelper::calcMatFromRect(glm::vec4(x * map.tileWidth, y * map.tileHeight, map.tileWidth, map.tileHeight), 0),
+						glm::vec4(1.0f), tiles[tile].tileRect);
+			}
+	}
+}
+
+void Map::updateChunkLayers(MapChunk &chunk, unsigned int cx, unsigned int cy)
+{
+	unsigned int endX = std::min((cx + 1) * MAP_CHUNK_SIZE, map.width);
+	unsigned int endY = std::min((cy + 1) * MAP_CHUNK_SIZE, map.height);
+	chunk.empty = true;
+	for(unsigned int l = 0; l < map.layers.size(); l++)
+	{
+		chunk.layerEmpty[l] = true;
+		for(unsigned int y = cy * MAP_CHUNK_SIZE; y < endY && chunk.layerEmpty[l]; y++)
+			for(unsigned int x = cx * MAP_CHUNK_SIZE; x < endX; x++)
+				if(map.layers[l].data[y * map.width + x] != 0)
+				{
+					chunk.layerEmpty[l] = false;
+					chunk.empty = false;
+					break;
+				}
+	}
+}
+
+void Map::SetTile(unsigned int layer, unsigned int x, unsigned int y, unsigned int tile)
+{
+	if(layer >= map.layers.size() || x >= map.width || y >= map.height || tile >= tiles.size())
+		throw std::runtime_error("tile set outside of map or with invalid tile id");
+	if(stream != nullptr)
+		throw std::runtime_error("tiles can't be set on a streamed map");
+	map.layers[layer].data[y * map.width + x] = tile;
+	unsigned int cx = x / MAP_CHUNK_SIZE;
+	unsigned int cy = y / MAP_CHUNK_SIZE;
+	MapChunk &chunk = chunks[cy * chunksX + cx];
+	updateChunkLayers(chunk, cx, cy);
+	//drawn tile by tile until rebaked
+	chunk.baked = false;
+}
+
+//composite every layer of the unbaked chunks into one texture each, tiles are drawn with depth testing
+//and no blending, so the first opaque pixel from the top layer is the one that shows
+void Map::Bake(Render &render)
+{
+	std::vector<unsigned char*> tilesetPixels(map.tilesets.size(), nullptr);
+	std::vector<int> tilesetWidths(map.tilesets.size(), 0);
+	std::vector<unsigned int> tileTileset(tiles.size(), 0);
+	for(unsigned int i = 0; i < map.tilesets.size(); i++)
+	{
+		int height, nrChannels;
+		tilesetPixels[i] = stbi_load(map.tilesets[i].imageSource.c_str(), &tilesetWidths[i], &height, &nrChannels, 4);
+		if(!tilesetPixels[i])
+			throw std::runtime_error("failed to load tileset image at " + map.tilesets[i].imageSource);
+		for(unsigned int id = map.tilesets[i].firstTileID;
+				id < map.tilesets[i].firstTileID + map.tilesets[i].tileCount && id < tiles.size(); id++)
+			tileTileset[id] = i;
+	}
+
+	unsigned int texturesLeft = render.TexturesLeft();
+	unsigned int budget = texturesLeft > MAP_TEXTURE_RESERVE ? texturesLeft - MAP_TEXTURE_RESERVE : 0;
+	unsigned int unbaked = 0;
+	for(unsigned int cy = 0; cy < chunksY; cy++)
+		for(unsigned int cx = 0; cx < chunksX; cx++)
 		{
-			if(!toDraw[j])
+			MapChunk &chunk = chunks[cy * chunksX + cx];
+			if(chunk.baked || chunk.empty)
 				continue;
-			if(map.layers[i - 1].data[j] != 0)
-				render.DrawQuad(tiles[map.layers[i - 1].data[j]].texture, tileMats[j], glm::vec4(1.0f), tiles[map.layers[i - 1].data[j]].tileRect);
+			if(budget == 0)
+			{
+				unbaked++;
+				continue;
+			}
+			budget--;
+			unsigned int texWidth = (unsigned int)chunk.rect.z;
+			unsigned int texHeight = (unsigned int)chunk.rect.w;
+			unsigned char* pixels = new unsigned char[texWidth * texHeight * 4];
+			std::memset(pixels, 0, texWidth * texHeight * 4);
+
+			for(unsigned int ty = 0; ty < texHeight / map.tileHeight; ty++)
+				for(unsigned int tx = 0; tx < texWidth / map.tileWidth; tx++)
+				{
+					unsigned int index = (cy * MAP_CHUNK_SIZE + ty) * map.width + cx * MAP_CHUNK_SIZE + tx;
+					for(unsigned int l = map.layers.size(); l > 0; l--)
+					{
+						unsigned int tile = map.layers[l - 1].data[index];
+						if(tile == 0 || tile >= tiles.size())
+							continue;
+						const tiled::Tileset &tileset = map.tilesets[tileTileset[tile]];
+						unsigned char* src = tilesetPixels[tileTileset[tile]];
+						unsigned int local = tile - tileset.firstTileID;
+						unsigned int srcX = (local % tileset.columns) * tileset.tileWidth;
+						unsigned int srcY = (local / tileset.columns) * tileset.tileHeight;
+						for(unsigned int py = 0; py < map.tileHeight; py++)
+							for(unsigned int px = 0; px < map.tileWidth; px++)
+							{
+								unsigned char* dst = pixels + ((ty * map.tileHeight + py) * texWidth + tx * map.tileWidth + px) * 4;
+								unsigned char* srcPx = src + ((srcY + py) * tilesetWidths[tileTileset[tile]] + srcX + px) * 4;
+								if(dst[3] == 0 && srcPx[3] != 0)
+									std::memcpy(dst, srcPx, 4);
+							}
+					}
+				}
+			chunk.texture = render.LoadTexture(pixels, texWidth, texHeight, 4);
+			chunk.baked = true;
 		}
-	}
-}
\ No newline at end of file
+
+	for(auto pixels: tilesetPixels)
+		stbi_image_free(pixels);
+	if(unbaked > 0)
+		std::cout << "out of textures to bake with, " << unbaked << " map chunks drawn tile by tile" << std::endl;
+}
@@ -3,8 +3,10 @@
 
 #include "tiled.h"
 #include "gamehelper.h"
-#include "vulkan-render/vkhelper.h"
-#include "vulkan-render/render.h"
+#include "tileOccupancy.h"
+#include "triggers.h"
+#include "renderer.h"
+#include "mapStream.h"
 
 #include <iostream>
 #include <vector>
@@ -12,9 +14,19 @@
 #include <map>
 #include <fstream>
 #include <string>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 
 //#define SEE_COLLIDERS;
 
+const unsigned int MAP_CHUNK_SIZE = 32; //in tiles
+//chunks of a streamed map kept around the camera's tiles and around the player's objects
+const unsigned int MAP_STREAM_RADIUS = 2;
+//textures left free for what loads after the maps (the font's glyphs, sprites), chunks past the
+//remaining budget are not baked and drawn tile by tile
+const unsigned int MAP_TEXTURE_RESERVE = 128;
+
 struct Tile
 {
 	glm::vec4 tileRect;
@@ -38,6 +50,26 @@ struct MapEnemy
 	EnemyTypes type;
 };
 
+struct MapChunk
+{
+	glm::vec4 rect;
+	std::vector<bool> layerEmpty;
+	bool empty = true;
+	bool baked = false;
+	Resource::Texture texture;
+};
+
+//what a chunk of a streamed map adds while it is near the player,
+//colliders crossing a chunk's edge are split between the chunks
+struct MapChunkObjects
+{
+	std::vector<glm::vec4> colliders;
+	std::vector<glm::vec4> gaps;
+	std::vector<glm::vec2> lights;
+	std::vector<MapEnemy> enemySpawns;
+	std::vector<glm::vec2> scientists;
+};
+
 struct MapMessage
 {
 	MapMessage(glm::vec4 rect, std::string fileName)
@@ -59,11 +91,29 @@ struct MapMessage
 class Map
 {
 public:
+	//loads the compiled map when it is up to date, otherwise parses the tmx without writing one
 	Map(std::string filename, Render &render);
 	Map(){}
+	//parses the tmx and writes the compiled map that the constructor loads in its place, returns false if it couldn't be written.
+	//only MapCompiler and the benchmarks call this, so running the game never writes into the resources
+	static bool Compile(std::string filename);
+	static std::string CompiledPath(std::string filename);
 	void Update(glm::vec4 cameraRect);
+	//infinite maps are streamed, only the chunks around the player and camera are in memory
+	bool Streamed() { return stream != nullptr; }
+	//streamed maps only, makes the chunks within MAP_STREAM_RADIUS of area the active ones and returns true if they changed.
+	//colliders, gaps, lights and the occupancy are then the active chunks', and the enemy and scientist spawns are
+	//those of chunks active for the first time since ResetActive
+	bool UpdateActive(glm::vec4 area);
+	void ResetActive();
 	void Draw(Render &render);
+	void SetTile(unsigned int layer, unsigned int x, unsigned int y, unsigned int tile);
+	//bakes unbaked chunks into textures while the renderer has more than MAP_TEXTURE_RESERVE left,
+	//only while render resources are loading
+	void Bake(Render &render);
 	glm::vec4 getMapRect() {return mapRect; }
+	//the part of the map with colliders, all of it unless streamed
+	glm::vec4 getActiveRect() { return stream != nullptr ? activeRect : mapRect; }
 	std::vector<glm::vec4> getCameraRects() { return cameraRects; }
 	std::vector<glm::vec4> getMapColliders() {return colliders;}
 	std::vector<glm::vec4> getGapColliders() { return gaps; }
@@ -73,6 +123,7 @@ public:
 	std::string getMusic() {return map.props.music;}
 	glm::vec4 getReactorRoom() { return reactorRoom; }
 	glm::vec4 getReactorTP() { return reactorTP; }
+	const TileOccupancy& getOccupancy() { return occupancy; }
 
 
 	std::string name;
@@ -83,18 +134,38 @@ public:
 
 	std::vector<glm::vec2> doors;
 	std::vector<glm::vec2> scientist;
+	//checkpoints, items, messages, doors and the reactor zones
+	TriggerIndex triggers;
 
 private:
 	tiled::Map map;
-	std::vector<glm::mat4> tileMats;
-	std::vector<bool> toDraw;
-	std::vector<glm::vec4> tileRects;
 	std::vector<Tile> tiles;
+	std::vector<MapChunk> chunks;
+	unsigned int chunksX = 0;
+	unsigned int chunksY = 0;
+
+	std::vector<std::string> loadTiled(std::string filename, std::vector<bool> &solid, std::vector<bool> &gap);
+	//in mapCompiled.cpp
+	bool loadCompiled(std::string path, std::vector<bool> &solid, std::vector<bool> &gap);
+	bool saveCompiled(std::string path, const std::vector<std::string> &sources,
+					const std::vector<bool> &solid, const std::vector<bool> &gap);
+	void writeStreamedChunks(std::ofstream &file, const std::vector<bool> &solid, const std::vector<bool> &gap);
+	void markObjectTiles(std::vector<bool> &solid, glm::vec4 rect);
+	std::vector<glm::vec4> mergeTileRects(std::vector<bool> solid, float rectHeight, bool mergeRows);
+	void updateChunkLayers(MapChunk &chunk, unsigned int cx, unsigned int cy);
+	void drawChunkTiles(Render &render, MapChunk &chunk, unsigned int cx, unsigned int cy);
+
+	//visible tile range from last update, end exclusive
+	unsigned int visibleStartX = 0;
+	unsigned int visibleStartY = 0;
+	unsigned int visibleEndX = 0;
+	unsigned int visibleEndY = 0;
 	std::vector<glm::vec4> cameraRects;
 	glm::vec4 mapRect;
 
 	std::vector<glm::vec4> colliders;
 	std::vector<glm::vec4> gaps;
+	TileOccupancy occupancy;
 	std::vector<MapEnemy> enemySpawns;
 	glm::vec2 playerSpawn;
 	std::vector<MapMessage> messageAreas;
@@ -102,6 +173,18 @@ private:
 	glm::vec4 reactorRoom = glm::vec4(0);
 	glm::vec4 reactorTP = glm::vec4(0);
 
+	//set for infinite maps, which read their tiles from the compiled map as they come near
+	std::shared_ptr<MapStream> stream;
+	std::vector<MapChunkObjects> chunkObjects;
+	std::vector<bool> chunkSpawned;
+	bool activeSet = false;
+	//active chunk range, end exclusive
+	unsigned int activeStartX = 0;
+	unsigned int activeStartY = 0;
+	unsigned int activeEndX = 0;
+	unsigned int activeEndY = 0;
+	glm::vec4 activeRect = glm::vec4(0);
+
 };
 
 
@@ -0,0 +1,591 @@
+#include "map.h"
+#include "mappedFile.h"
+
+#include <stdint.h>
+#include <cstdio>
+#include <utility>
+#include <memory>
+
+//the compiled map holds everything loadTiled produces: the tiled map without its object groups, the merged colliders,
+//the tile occupancy, every object list and the message text. It starts with a hash of every file loadTiled read,
+//so editing the tmx, a tileset or a message makes it stale and the map is parsed again.
+//Infinite maps are stored a chunk at a time instead, with each chunk's objects and a block of its tiles,
+//solid and gap bytes at the end of the file for MapStream to read as the chunk comes near.
+//Uses the machine's byte order, bump the version whenever loadTiled or the layout changes
+const char MAP_COMPILED_MAGIC[4] = { 'G', 'B', 'J', 'M' };
+const uint32_t MAP_COMPILED_VERSION = 2;
+const std::string MAP_COMPILED_EXTENSION = ".mapbin";
+
+namespace
+{
+
+//FNV-1a over 8 bytes at a time, the tmx of a large map is hashed on every load.
+//missing and empty files hash the same, which is fine as they load the same
+uint64_t hashFile(std::string path)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	gh::MappedFile file;
+	if(!file.Open(path))
+		return hash;
+	const unsigned char* data = file.Data();
+	size_t i = 0;
+	for(; i + sizeof(uint64_t) <= file.Size(); i += sizeof(uint64_t))
+	{
+		uint64_t word;
+		std::memcpy(&word, data + i, sizeof(uint64_t));
+		hash ^= word;
+		hash *= 1099511628211ULL;
+	}
+	for(; i < file.Size(); i++)
+	{
+		hash ^= data[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+//reads straight out of the mapped file, fails instead of reading past the end
+struct CompiledReader
+{
+	CompiledReader(const unsigned char* data, size_t size)
+	{
+		this->data = data;
+		this->size = size;
+	}
+
+	void bytes(void* out, size_t count)
+	{
+		if(!ok || count > size - pos)
+		{
+			ok = false;
+			return;
+		}
+		std::memcpy(out, data + pos, count);
+		pos += count;
+	}
+
+	template <typename T>
+	T get()
+	{
+		T value = T();
+		bytes(&value, sizeof(T));
+		return value;
+	}
+
+	std::string string()
+	{
+		uint32_t length = get<uint32_t>();
+		if(!ok || length > size - pos)
+		{
+			ok = false;
+			return "";
+		}
+		std::string value((const char*)data + pos, length);
+		pos += length;
+		return value;
+	}
+
+	template <typename T>
+	void array(std::vector<T> &values)
+	{
+		uint32_t count = get<uint32_t>();
+		if(!ok || count > (size - pos) / sizeof(T))
+		{
+			ok = false;
+			return;
+		}
+		values.resize(count);
+		if(count > 0)
+			bytes(&values[0], count * sizeof(T));
+	}
+
+	void bits(std::vector<bool> &values, size_t count)
+	{
+		if(!ok || count > size - pos)
+		{
+			ok = false;
+			return;
+		}
+		values.resize(count);
+		for(size_t i = 0; i < count; i++)
+			values[i] = data[pos + i] != 0;
+		pos += count;
+	}
+
+	const unsigned char* data;
+	size_t size;
+	size_t pos = 0;
+	bool ok = true;
+};
+
+template <typename T>
+void write(std::ofstream &file, const T &value)
+{
+	file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeString(std::ofstream &file, const std::string &value)
+{
+	write(file, (uint32_t)value.size());
+	file.write(value.data(), value.size());
+}
+
+template <typename T>
+void writeArray(std::ofstream &file, const std::vector<T> &values)
+{
+	write(file, (uint32_t)values.size());
+	if(values.size() > 0)
+		file.write(reinterpret_cast<const char*>(&values[0]), values.size() * sizeof(T));
+}
+
+void writeBits(std::ofstream &file, const std::vector<bool> &values)
+{
+	std::vector<unsigned char> bytes(values.begin(), values.end());
+	if(bytes.size() > 0)
+		file.write(reinterpret_cast<const char*>(&bytes[0]), bytes.size());
+}
+
+void writeEnemies(std::ofstream &file, const std::vector<MapEnemy> &enemies)
+{
+	write(file, (uint32_t)enemies.size());
+	for(const auto &enemy: enemies)
+	{
+		write(file, enemy.spawn);
+		write(file, (uint32_t)enemy.type);
+	}
+}
+
+void readEnemies(CompiledReader &in, std::vector<MapEnemy> &enemies)
+{
+	uint32_t enemyCount = in.get<uint32_t>();
+	for(uint32_t i = 0; i < enemyCount && in.ok; i++)
+	{
+		glm::vec2 spawn = in.get<glm::vec2>();
+		enemies.push_back(MapEnemy(spawn, (EnemyTypes)in.get<uint32_t>()));
+	}
+}
+
+//bytes of a streamed chunk's block, its tiles layer after layer then its solid and gap bytes
+size_t chunkBlockSize(size_t layerCount)
+{
+	return (layerCount * sizeof(unsigned int) + 2) * MAP_CHUNK_SIZE * MAP_CHUNK_SIZE;
+}
+
+unsigned int chunkAt(float pos, float chunkSize, unsigned int chunkCount)
+{
+	float chunk = std::floor(pos / chunkSize);
+	if(chunk < 0)
+		return 0;
+	if(chunk >= chunkCount)
+		return chunkCount - 1;
+	return (unsigned int)chunk;
+}
+
+//adds the part of rect in each chunk it crosses, the edge chunks reach past the map so nothing is lost
+void splitRect(std::vector<MapChunkObjects> &chunks, std::vector<glm::vec4> MapChunkObjects::*list, glm::vec4 rect,
+			glm::vec2 chunkSize, unsigned int chunksX, unsigned int chunksY)
+{
+	unsigned int sX = chunkAt(rect.x, chunkSize.x, chunksX);
+	unsigned int sY = chunkAt(rect.y, chunkSize.y, chunksY);
+	unsigned int eX = chunkAt(rect.x + rect.z, chunkSize.x, chunksX);
+	unsigned int eY = chunkAt(rect.y + rect.w, chunkSize.y, chunksY);
+	for(unsigned int cy = sY; cy <= eY; cy++)
+		for(unsigned int cx = sX; cx <= eX; cx++)
+		{
+			float left = cx == 0 ? rect.x : std::max(rect.x, cx * chunkSize.x);
+			float top = cy == 0 ? rect.y : std::max(rect.y, cy * chunkSize.y);
+			float right = cx == chunksX - 1 ? rect.x + rect.z : std::min(rect.x + rect.z, (cx + 1) * chunkSize.x);
+			float bottom = cy == chunksY - 1 ? rect.y + rect.w : std::min(rect.y + rect.w, (cy + 1) * chunkSize.y);
+			//a rect ending on a chunk's edge doesn't reach into the next one
+			if((rect.z > 0 && right <= left) || (rect.w > 0 && bottom <= top))
+				continue;
+			(chunks[cy * chunksX + cx].*list).push_back(glm::vec4(left, top, right - left, bottom - top));
+		}
+}
+
+} //namespace end
+
+std::string Map::CompiledPath(std::string filename)
+{
+	size_t ext = filename.find_last_of('.');
+	if(ext != std::string::npos && filename.substr(ext) == ".tmx")
+		filename = filename.substr(0, ext);
+	return filename + MAP_COMPILED_EXTENSION;
+}
+
+bool Map::Compile(std::string filename)
+{
+	Map map;
+	std::vector<bool> solid;
+	std::vector<bool> gap;
+	std::vector<std::string> sources = map.loadTiled(filename, solid, gap);
+	return map.saveCompiled(CompiledPath(filename), sources, solid, gap);
+}
+
+bool Map::loadCompiled(std::string path, std::vector<bool> &solid, std::vector<bool> &gap)
+{
+	//streamed maps keep the file mapped for their chunks
+	std::shared_ptr<gh::MappedFile> file(new gh::MappedFile());
+	if(!file->Open(path))
+		return false;
+	CompiledReader in(file->Data(), file->Size());
+
+	char magic[4];
+	in.bytes(magic, sizeof(magic));
+	if(!in.ok || std::memcmp(magic, MAP_COMPILED_MAGIC, sizeof(magic)) != 0
+		|| in.get<uint32_t>() != MAP_COMPILED_VERSION)
+	{
+		std::cout << "map " << path << ": compiled map is from another version, parsing the tmx instead" << std::endl;
+		return false;
+	}
+	uint32_t sourceCount = in.get<uint32_t>();
+	for(uint32_t i = 0; i < sourceCount && in.ok; i++)
+	{
+		std::string source = in.string();
+		uint64_t hash = in.get<uint64_t>();
+		if(in.ok && hashFile(source) != hash)
+		{
+			std::cout << "map " << path << ": " << source << " changed since compiling, parsing the tmx instead" << std::endl;
+			return false;
+		}
+	}
+
+	tiled::Map loaded;
+	bool streamed = in.get<uint8_t>() != 0;
+	loaded.infinite = streamed;
+	loaded.width = in.get<uint32_t>();
+	loaded.height = in.get<uint32_t>();
+	loaded.tileWidth = in.get<uint32_t>();
+	loaded.tileHeight = in.get<uint32_t>();
+	loaded.totalTiles = in.get<uint32_t>();
+	loaded.originX = in.get<int32_t>();
+	loaded.originY = in.get<int32_t>();
+	loaded.props.music = in.string();
+	uint32_t tilesetCount = in.get<uint32_t>();
+	for(uint32_t i = 0; i < tilesetCount && in.ok; i++)
+	{
+		loaded.tilesets.push_back(tiled::Tileset());
+		tiled::Tileset &tileset = loaded.tilesets.back();
+		tileset.firstTileID = in.get<uint32_t>();
+		tileset.source = in.string();
+		tileset.name = in.string();
+		tileset.tileWidth = in.get<uint32_t>();
+		tileset.tileHeight = in.get<uint32_t>();
+		tileset.tileCount = in.get<uint32_t>();
+		tileset.columns = in.get<uint32_t>();
+		tileset.imageSource = in.string();
+		tileset.imageWidth = in.get<uint32_t>();
+		tileset.imageHeight = in.get<uint32_t>();
+	}
+	size_t tileCount = (size_t)loaded.width * loaded.height;
+	uint32_t layerCount = in.get<uint32_t>();
+	for(uint32_t i = 0; i < layerCount && in.ok; i++)
+	{
+		loaded.layers.push_back(tiled::Layer());
+		tiled::Layer &layer = loaded.layers.back();
+		layer.props.collidable = in.get<uint8_t>() != 0;
+		layer.props.gap = in.get<uint8_t>() != 0;
+		if(streamed)
+			continue;
+		in.array(layer.data);
+		if(layer.data.size() != tileCount)
+			in.ok = false;
+	}
+
+	in.array(cameraRects);
+	in.array(items);
+	in.array(checkpoints);
+	in.array(doors);
+	uint32_t messageCount = in.get<uint32_t>();
+	for(uint32_t i = 0; i < messageCount && in.ok; i++)
+	{
+		messageAreas.push_back(MapMessage());
+		messageAreas.back().rect = in.get<glm::vec4>();
+		uint32_t lineCount = in.get<uint32_t>();
+		for(uint32_t l = 0; l < lineCount && in.ok; l++)
+			messageAreas.back().messages.push_back(in.string());
+	}
+	playerSpawn = in.get<glm::vec2>();
+	reactorRoom = in.get<glm::vec4>();
+	reactorTP = in.get<glm::vec4>();
+
+	std::vector<uint64_t> blocks;
+	if(!streamed)
+	{
+		in.bits(solid, tileCount);
+		in.bits(gap, tileCount);
+		in.array(colliders);
+		in.array(gaps);
+		in.array(lights);
+		in.array(scientist);
+		readEnemies(in, enemySpawns);
+		if(in.pos != in.size)
+			in.ok = false;
+	}
+	else
+	{
+		chunksX = in.get<uint32_t>();
+		chunksY = in.get<uint32_t>();
+		size_t chunkCount = (size_t)chunksX * chunksY;
+		if(chunksX != (loaded.width + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE
+			|| chunksY != (loaded.height + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE
+			|| chunkCount > (in.size - in.pos) / sizeof(uint64_t))
+			in.ok = false;
+		if(!in.ok)
+			chunkCount = 0;
+		chunks.resize(chunkCount);
+		blocks.resize(chunkCount);
+		for(size_t c = 0; c < chunkCount && in.ok; c++)
+		{
+			chunks[c].layerEmpty.resize(layerCount);
+			for(uint32_t l = 0; l < layerCount; l++)
+			{
+				chunks[c].layerEmpty[l] = in.get<uint8_t>() != 0;
+				if(!chunks[c].layerEmpty[l])
+					chunks[c].empty = false;
+			}
+			blocks[c] = in.get<uint64_t>();
+		}
+		chunkObjects.resize(chunkCount);
+		for(size_t c = 0; c < chunkCount && in.ok; c++)
+		{
+			in.array(chunkObjects[c].colliders);
+			in.array(chunkObjects[c].gaps);
+			in.array(chunkObjects[c].lights);
+			in.array(chunkObjects[c].scientists);
+			readEnemies(in, chunkObjects[c].enemySpawns);
+		}
+		size_t blockSize = chunkBlockSize(layerCount);
+		for(size_t c = 0; c < chunkCount && in.ok; c++)
+			if(blocks[c] != 0 && (blocks[c] < in.pos || blocks[c] > in.size || blockSize > in.size - blocks[c]))
+				in.ok = false;
+	}
+
+	if(!in.ok)
+	{
+		std::cout << "map " << path << ": compiled map is corrupt, parsing the tmx instead" << std::endl;
+		*this = Map();
+		solid.clear();
+		gap.clear();
+		return false;
+	}
+	map = std::move(loaded);
+	if(streamed)
+	{
+		stream = std::make_shared<MapStream>(file, blocks, chunksX, layerCount, MAP_CHUNK_SIZE * MAP_CHUNK_SIZE);
+		chunkSpawned.assign(chunks.size(), false);
+		std::cout << "map " << path << ": loaded compiled map streaming " << chunks.size() << " chunks" << std::endl;
+	}
+	else
+		std::cout << "map " << path << ": loaded compiled map with " << colliders.size() << " colliders, "
+			<< gaps.size() << " gaps" << std::endl;
+	return true;
+}
+
+bool Map::saveCompiled(std::string path, const std::vector<std::string> &sources,
+					const std::vector<bool> &solid, const std::vector<bool> &gap)
+{
+	//written beside the real file then swapped in, so a failed write never leaves half a map to load
+	std::string tempPath = path + ".tmp";
+	std::ofstream file(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+	if(!file)
+	{
+		std::cout << "map " << path << ": couldn't write compiled map" << std::endl;
+		return false;
+	}
+	file.write(MAP_COMPILED_MAGIC, sizeof(MAP_COMPILED_MAGIC));
+	write(file, MAP_COMPILED_VERSION);
+	write(file, (uint32_t)sources.size());
+	for(const auto &source: sources)
+	{
+		writeString(file, source);
+		write(file, hashFile(source));
+	}
+
+	write(file, (uint8_t)map.infinite);
+	write(file, (uint32_t)map.width);
+	write(file, (uint32_t)map.height);
+	write(file, (uint32_t)map.tileWidth);
+	write(file, (uint32_t)map.tileHeight);
+	write(file, (uint32_t)map.totalTiles);
+	write(file, (int32_t)map.originX);
+	write(file, (int32_t)map.originY);
+	writeString(file, map.props.music);
+	write(file, (uint32_t)map.tilesets.size());
+	for(const auto &tileset: map.tilesets)
+	{
+		write(file, (uint32_t)tileset.firstTileID);
+		writeString(file, tileset.source);
+		writeString(file, tileset.name);
+		write(file, (uint32_t)tileset.tileWidth);
+		write(file, (uint32_t)tileset.tileHeight);
+		write(file, (uint32_t)tileset.tileCount);
+		write(file, (uint32_t)tileset.columns);
+		writeString(file, tileset.imageSource);
+		write(file, (uint32_t)tileset.imageWidth);
+		write(file, (uint32_t)tileset.imageHeight);
+	}
+	write(file, (uint32_t)map.layers.size());
+	for(const auto &layer: map.layers)
+	{
+		write(file, (uint8_t)layer.props.collidable);
+		write(file, (uint8_t)layer.props.gap);
+		if(!map.infinite)
+			writeArray(file, layer.data);
+	}
+
+	writeArray(file, cameraRects);
+	writeArray(file, items);
+	writeArray(file, checkpoints);
+	writeArray(file, doors);
+	write(file, (uint32_t)messageAreas.size());
+	for(const auto &message: messageAreas)
+	{
+		write(file, message.rect);
+		write(file, (uint32_t)message.messages.size());
+		for(const auto &line: message.messages)
+			writeString(file, line);
+	}
+	write(file, playerSpawn);
+	write(file, reactorRoom);
+	write(file, reactorTP);
+
+	if(map.infinite)
+		writeStreamedChunks(file, solid, gap);
+	else
+	{
+		writeBits(file, solid);
+		writeBits(file, gap);
+		writeArray(file, colliders);
+		writeArray(file, gaps);
+		writeArray(file, lights);
+		writeArray(file, scientist);
+		writeEnemies(file, enemySpawns);
+	}
+
+	file.close();
+	if(!file)
+	{
+		std::remove(tempPath.c_str());
+		std::cout << "map " << path << ": couldn't write compiled map" << std::endl;
+		return false;
+	}
+	std::remove(path.c_str());
+	if(std::rename(tempPath.c_str(), path.c_str()) != 0)
+	{
+		std::remove(tempPath.c_str());
+		std::cout << "map " << path << ": couldn't write compiled map" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+//the chunk table, each chunk's objects, then a block for every chunk with tiles, solid or gap in it.
+//the table is written again once the blocks are placed
+void Map::writeStreamedChunks(std::ofstream &file, const std::vector<bool> &solid, const std::vector<bool> &gap)
+{
+	const unsigned int chunkTiles = MAP_CHUNK_SIZE * MAP_CHUNK_SIZE;
+	unsigned int chunksX = (map.width + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE;
+	unsigned int chunksY = (map.height + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE;
+	size_t chunkCount = (size_t)chunksX * chunksY;
+	size_t layerCount = map.layers.size();
+	write(file, (uint32_t)chunksX);
+	write(file, (uint32_t)chunksY);
+
+	std::streampos table = file.tellp();
+	std::vector<unsigned char> layerEmpty(chunkCount * layerCount, 1);
+	std::vector<uint64_t> blocks(chunkCount, 0);
+	for(size_t c = 0; c < chunkCount; c++)
+	{
+		if(layerCount > 0)
+			file.write(reinterpret_cast<const char*>(&layerEmpty[c * layerCount]), layerCount);
+		write(file, blocks[c]);
+	}
+
+	glm::vec2 chunkSize(MAP_CHUNK_SIZE * map.tileWidth, MAP_CHUNK_SIZE * map.tileHeight);
+	std::vector<MapChunkObjects> objects(chunkCount);
+	for(const auto &rect: colliders)
+		splitRect(objects, &MapChunkObjects::colliders, rect, chunkSize, chunksX, chunksY);
+	for(const auto &rect: gaps)
+		splitRect(objects, &MapChunkObjects::gaps, rect, chunkSize, chunksX, chunksY);
+	for(const auto &light: lights)
+		objects[chunkAt(light.y, chunkSize.y, chunksY) * chunksX + chunkAt(light.x, chunkSize.x, chunksX)].lights.push_back(light);
+	for(const auto &s: scientist)
+		objects[chunkAt(s.y, chunkSize.y, chunksY) * chunksX + chunkAt(s.x, chunkSize.x, chunksX)].scientists.push_back(s);
+	for(const auto &e: enemySpawns)
+		objects[chunkAt(e.spawn.y, chunkSize.y, chunksY) * chunksX + chunkAt(e.spawn.x, chunkSize.x, chunksX)].enemySpawns.push_back(e);
+	for(const auto &chunk: objects)
+	{
+		writeArray(file, chunk.colliders);
+		writeArray(file, chunk.gaps);
+		writeArray(file, chunk.lights);
+		writeArray(file, chunk.scientists);
+		writeEnemies(file, chunk.enemySpawns);
+	}
+
+	//the tiled chunks over each of ours, so the map's layers are never made dense
+	std::vector<std::vector<std::pair<size_t, const tiled::LayerChunk*>>> parts(chunkCount);
+	for(size_t l = 0; l < layerCount; l++)
+		for(const auto &chunk: map.layers[l].chunks)
+		{
+			if(chunk.width == 0 || chunk.height == 0)
+				continue;
+			for(unsigned int cy = chunk.y / MAP_CHUNK_SIZE; cy <= (chunk.y + chunk.height - 1) / MAP_CHUNK_SIZE; cy++)
+				for(unsigned int cx = chunk.x / MAP_CHUNK_SIZE; cx <= (chunk.x + chunk.width - 1) / MAP_CHUNK_SIZE; cx++)
+					parts[cy * chunksX + cx].push_back(std::make_pair(l, &chunk));
+		}
+
+	std::vector<unsigned int> block(layerCount * chunkTiles);
+	std::vector<unsigned char> occupied(2 * chunkTiles);
+	for(unsigned int cy = 0; cy < chunksY; cy++)
+		for(unsigned int cx = 0; cx < chunksX; cx++)
+		{
+			size_t c = (size_t)cy * chunksX + cx;
+			std::fill(block.begin(), block.end(), 0);
+			std::fill(occupied.begin(), occupied.end(), 0);
+			bool used = false;
+			for(const auto &part: parts[c])
+			{
+				const tiled::LayerChunk &chunk = *part.second;
+				unsigned int startX = std::max<unsigned int>(chunk.x, cx * MAP_CHUNK_SIZE);
+				unsigned int startY = std::max<unsigned int>(chunk.y, cy * MAP_CHUNK_SIZE);
+				unsigned int endX = std::min<unsigned int>(chunk.x + chunk.width, (cx + 1) * MAP_CHUNK_SIZE);
+				unsigned int endY = std::min<unsigned int>(chunk.y + chunk.height, (cy + 1) * MAP_CHUNK_SIZE);
+				for(unsigned int y = startY; y < endY; y++)
+					for(unsigned int x = startX; x < endX; x++)
+					{
+						unsigned int tile = chunk.data[(y - chunk.y) * chunk.width + x - chunk.x];
+						if(tile == 0)
+							continue;
+						block[part.first * chunkTiles + (y - cy * MAP_CHUNK_SIZE) * MAP_CHUNK_SIZE + x - cx * MAP_CHUNK_SIZE] = tile;
+						layerEmpty[c * layerCount + part.first] = 0;
+						used = true;
+					}
+			}
+			unsigned int endX = std::min((cx + 1) * MAP_CHUNK_SIZE, map.width);
+			unsigned int endY = std::min((cy + 1) * MAP_CHUNK_SIZE, map.height);
+			for(unsigned int y = cy * MAP_CHUNK_SIZE; y < endY; y++)
+				for(unsigned int x = cx * MAP_CHUNK_SIZE; x < endX; x++)
+				{
+					size_t i = (size_t)y * map.width + x;
+					size_t local = (y - cy * MAP_CHUNK_SIZE) * MAP_CHUNK_SIZE + x - cx * MAP_CHUNK_SIZE;
+					occupied[local] = solid[i];
+					occupied[chunkTiles + local] = gap[i];
+					used = used || solid[i] || gap[i];
+				}
+			if(!used)
+				continue;
+			blocks[c] = (uint64_t)file.tellp();
+			if(layerCount > 0)
+				file.write(reinterpret_cast<const char*>(&block[0]), block.size() * sizeof(unsigned int));
+			file.write(reinterpret_cast<const char*>(&occupied[0]), occupied.size());
+		}
+
+	file.seekp(table);
+	for(size_t c = 0; c < chunkCount; c++)
+	{
+		if(layerCount > 0)
+			file.write(reinterpret_cast<const char*>(&layerEmpty[c * layerCount]), layerCount);
+		write(file, blocks[c]);
+	}
+}
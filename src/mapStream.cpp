@@ -0,0 +1,70 @@
+#include "mapStream.h"
+
+#include <cstring>
+
+MapStream::MapStream(std::shared_ptr<gh::MappedFile> file, const std::vector<uint64_t> &blocks, unsigned int chunksX,
+			unsigned int layerCount, unsigned int chunkTiles)
+{
+	this->file = file;
+	this->blocks = blocks;
+	this->chunksX = chunksX;
+	blockTiles = (size_t)layerCount * chunkTiles;
+	tiles.resize(blocks.size());
+	state.reset(new std::atomic<int>[blocks.size()]);
+	for(size_t i = 0; i < blocks.size(); i++)
+		state[i].store(Dropped);
+}
+
+MapStream::~MapStream()
+{
+	gh::JobSystem::Get().Wait(loading);
+}
+
+void MapStream::Request(unsigned int startX, unsigned int startY, unsigned int endX, unsigned int endY)
+{
+	//chunks still loading are dropped on a later request, once their job is done with them
+	for(size_t i = 0; i < requested.size();)
+	{
+		unsigned int chunk = requested[i];
+		unsigned int x = chunk % chunksX;
+		unsigned int y = chunk / chunksX;
+		if((x >= startX && x < endX && y >= startY && y < endY) || state[chunk].load() != Loaded)
+		{
+			i++;
+			continue;
+		}
+		std::vector<unsigned int>().swap(tiles[chunk]);
+		state[chunk].store(Dropped);
+		requested[i] = requested.back();
+		requested.pop_back();
+	}
+
+	for(unsigned int y = startY; y < endY; y++)
+		for(unsigned int x = startX; x < endX; x++)
+		{
+			unsigned int chunk = y * chunksX + x;
+			if(blocks[chunk] == 0 || blockTiles == 0 || state[chunk].load() != Dropped)
+				continue;
+			state[chunk].store(Loading);
+			requested.push_back(chunk);
+			gh::JobSystem::Get().Run([this, chunk] {
+				tiles[chunk].resize(blockTiles);
+				std::memcpy(&tiles[chunk][0], Block(chunk), blockTiles * sizeof(unsigned int));
+				state[chunk].store(Loaded);
+			}, &loading);
+		}
+}
+
+const unsigned int* MapStream::Tiles(unsigned int chunk) const
+{
+	if(state[chunk].load() != Loaded)
+		return nullptr;
+	return &tiles[chunk][0];
+}
+
+const unsigned char* MapStream::Block(unsigned int chunk) const
+{
+	if(blocks[chunk] == 0)
+		return nullptr;
+	return file->Data() + blocks[chunk];
+}
@@ -0,0 +1,52 @@
+#ifndef MAP_STREAM_H
+#define MAP_STREAM_H
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <stdint.h>
+
+#include "mappedFile.h"
+#include "jobSystem.h"
+
+//tile data of a streamed map's chunks. Chunks that are asked for are copied out of the mapped
+//compiled map on a job thread, and dropped again once they stop being asked for
+class MapStream
+{
+public:
+	//blocks are where each chunk's data starts in the file, 0 for chunks with nothing in them.
+	//a block starts with chunkTiles ids for every layer
+	MapStream(std::shared_ptr<gh::MappedFile> file, const std::vector<uint64_t> &blocks, unsigned int chunksX,
+			unsigned int layerCount, unsigned int chunkTiles);
+	~MapStream();
+	//loads the chunks in range that aren't loaded and drops any others, end exclusive
+	void Request(unsigned int startX, unsigned int startY, unsigned int endX, unsigned int endY);
+	//the chunk's tile ids layer after layer, nullptr until its load finishes
+	const unsigned int* Tiles(unsigned int chunk) const;
+	//straight from the mapped file, nullptr for chunks with nothing in them
+	const unsigned char* Block(unsigned int chunk) const;
+	unsigned int LoadedCount() const { return (unsigned int)requested.size(); }
+
+private:
+	MapStream(const MapStream&);
+	MapStream& operator=(const MapStream&);
+
+	enum ChunkState
+	{
+		Dropped,
+		Loading,
+		Loaded,
+	};
+
+	std::shared_ptr<gh::MappedFile> file;
+	std::vector<uint64_t> blocks;
+	unsigned int chunksX;
+	size_t blockTiles;
+	std::vector<std::vector<unsigned int>> tiles;
+	std::unique_ptr<std::atomic<int>[]> state;
+	//chunks that are loading or loaded, only touched by the thread making requests
+	std::vector<unsigned int> requested;
+	gh::JobCounter loading;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#include "mappedFile.h"
+
+#if defined(_WIN32) || defined(WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace gh
+{
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+#if defined(_WIN32) || defined(WIN32)
+
+bool MappedFile::Open(std::string path)
+{
+	Close();
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER fileSize;
+	if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if(mapping == NULL)
+	{
+		CloseHandle(file);
+		return false;
+	}
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if(view == NULL)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+	fileHandle = file;
+	mappingHandle = mapping;
+	data = (const unsigned char*)view;
+	size = (size_t)fileSize.QuadPart;
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if(data != nullptr)
+		UnmapViewOfFile(data);
+	if(mappingHandle != nullptr)
+		CloseHandle(mappingHandle);
+	if(fileHandle != nullptr)
+		CloseHandle(fileHandle);
+	data = nullptr;
+	size = 0;
+	fileHandle = nullptr;
+	mappingHandle = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(std::string path)
+{
+	Close();
+	int file = open(path.c_str(), O_RDONLY);
+	if(file < 0)
+		return false;
+	struct stat info;
+	if(fstat(file, &info) != 0 || info.st_size == 0)
+	{
+		close(file);
+		return false;
+	}
+	void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	//the mapping keeps its own reference to the file
+	close(file);
+	if(view == MAP_FAILED)
+		return false;
+	data = (const unsigned char*)view;
+	size = (size_t)info.st_size;
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if(data != nullptr)
+		munmap((void*)data, size);
+	data = nullptr;
+	size = 0;
+}
+
+#endif
+
+} //namespace end
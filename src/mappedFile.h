@@ -0,0 +1,36 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <stddef.h>
+
+namespace gh
+{
+
+//maps a whole file read only into memory, the data stays valid until the MappedFile is destroyed
+class MappedFile
+{
+public:
+	MappedFile() {}
+	~MappedFile();
+	//returns false if the file is missing or could not be mapped
+	bool Open(std::string path);
+	void Close();
+	const unsigned char* Data() const { return data; }
+	size_t Size() const { return size; }
+
+private:
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+	const unsigned char* data = nullptr;
+	size_t size = 0;
+#if defined(_WIN32) || defined(WIN32)
+	void* fileHandle = nullptr;
+	void* mappingHandle = nullptr;
+#endif
+};
+
+} //namespace end
+
+#endif
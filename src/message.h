@@ -2,16 +2,8 @@
 #define MESSAGE_H
 
 #include "glm/glm.hpp"
-#ifndef GLFW_INCLUDE_VULKAN
-#define GLFW_INCLUDE_VULKAN
-#endif
-#include <GLFW/glfw3.h>
-
-#include "vulkan-render/texture_loader.h"
-#include "vulkan-render/texfont.h"
-#include "vulkan-render/render.h"
-#include "vulkan-render/vkhelper.h"
-#include "vulkan-render/config.h"
+
+#include "renderer.h"
 
 #include "timer.h"
 #include "input.h"
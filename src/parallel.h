@@ -0,0 +1,45 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+#include "jobSystem.h"
+
+//runs every parallel range on the calling thread, results are the same either way
+//#define SINGLE_THREADED_UPDATE
+
+namespace gh
+{
+	//splits [0, count) into ranges that are multiples of grain and runs them as jobs.
+	//each index belongs to exactly one range, so as long as fn only writes to its own indices
+	//the result doesn't depend on how many threads ran
+	static void ParallelFor(unsigned int count, unsigned int grain, const std::function<void(unsigned int, unsigned int)> &fn)
+	{
+		if(count == 0)
+			return;
+		unsigned int threads = JobSystem::Get().ThreadCount();
+#ifdef SINGLE_THREADED_UPDATE
+		threads = 1;
+#endif
+		unsigned int ranges = std::min(threads, (count + grain - 1) / grain);
+		if(ranges <= 1)
+		{
+			fn(0, count);
+			return;
+		}
+		unsigned int per = ((count + ranges - 1) / ranges + grain - 1) / grain * grain;
+		JobCounter counter;
+		for(unsigned int begin = per; begin < count; begin += per)
+		{
+			unsigned int end = std::min(count, begin + per);
+			JobSystem::Get().Run([&fn, begin, end] { fn(begin, end); }, &counter);
+		}
+		fn(0, std::min(count, per));
+		JobSystem::Get().Wait(counter);
+	}
+
+} //namespace end
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+//the game reaches the renderer through here, HEADLESS builds swap in one that draws nothing
+#ifdef HEADLESS
+#include "headless/nullRender.h"
+#else
+#ifndef GLFW_INCLUDE_VULKAN
+#define GLFW_INCLUDE_VULKAN
+#endif
+#include <GLFW/glfw3.h>
+#include "vulkan-render/render.h"
+#include "vulkan-render/texture_loader.h"
+#include "vulkan-render/vkhelper.h"
+#include "vulkan-render/texfont.h"
+#endif
+#include "vulkan-render/config.h"
+
+#endif
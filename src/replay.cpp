@@ -0,0 +1,179 @@
+#include "replay.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <ctime>
+#include <algorithm>
+
+#include "gamehelper.h"
+
+namespace gh
+{
+
+const char REPLAY_MAGIC[4] = { 'G', 'B', 'J', 'R' };
+const uint32_t REPLAY_VERSION = 1;
+
+//which parts of the input a frame stores
+enum ReplayFlags : uint8_t
+{
+	ReplayKeys = 1 << 0,
+	ReplayButtons = 1 << 1,
+	ReplayMouse = 1 << 2,
+	ReplayScroll = 1 << 3,
+};
+
+template <typename T>
+static void write(std::fstream &file, const T &value)
+{
+	file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool read(std::fstream &file, T &value)
+{
+	return (bool)file.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+Replay::~Replay()
+{
+	if(mode == ReplayMode::Record)
+		std::cout << "recorded " << frameCount << " frames to " << path << std::endl;
+}
+
+void Replay::Record(std::string path)
+{
+	this->path = path;
+	file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+	if(!file)
+		throw std::runtime_error("failed to open replay file for recording at " + path);
+	uint32_t seed = (uint32_t)time(0);
+	gh::Random::SetSeed(seed);
+	file.write(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+	write(file, REPLAY_VERSION);
+	write(file, seed);
+	mode = ReplayMode::Record;
+}
+
+void Replay::Play(std::string path)
+{
+	this->path = path;
+	file.open(path, std::ios::in | std::ios::binary);
+	if(!file)
+		throw std::runtime_error("failed to open replay file at " + path);
+	char magic[4];
+	uint32_t version, seed;
+	if(!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, REPLAY_MAGIC))
+		throw std::runtime_error("not a replay file: " + path);
+	if(!read(file, version) || version != REPLAY_VERSION)
+		throw std::runtime_error("unsupported replay version in " + path);
+	if(!read(file, seed))
+		throw std::runtime_error("replay file ended before the seed: " + path);
+	gh::Random::SetSeed(seed);
+	mode = ReplayMode::Play;
+}
+
+bool Replay::Frame(double &frameTime, Input &input)
+{
+	switch(mode)
+	{
+		case ReplayMode::Record:
+			writeFrame(frameTime, input);
+			return true;
+		case ReplayMode::Play:
+			if(readFrame(frameTime, input))
+				return true;
+			std::cout << "replay finished after " << frameCount << " frames" << std::endl;
+			mode = ReplayMode::Off;
+			return false;
+		default:
+			return true;
+	}
+}
+
+void Replay::writeFrame(double frameTime, const Input &input)
+{
+	changedKeys.clear();
+	for(uint16_t i = 0; i < 1024; i++)
+		if(input.Keys[i] != last.Keys[i])
+			changedKeys.push_back(i);
+	uint8_t buttons = 0;
+	for(unsigned int i = 0; i < 8; i++)
+		if(input.Buttons[i])
+			buttons |= 1 << i;
+	uint8_t lastButtons = 0;
+	for(unsigned int i = 0; i < 8; i++)
+		if(last.Buttons[i])
+			lastButtons |= 1 << i;
+
+	uint8_t flags = 0;
+	if(changedKeys.size() > 0)
+		flags |= ReplayKeys;
+	if(buttons != lastButtons)
+		flags |= ReplayButtons;
+	if(input.X != last.X || input.Y != last.Y)
+		flags |= ReplayMouse;
+	if(input.offset != last.offset)
+		flags |= ReplayScroll;
+
+	write(file, frameTime);
+	write(file, flags);
+	if(flags & ReplayKeys)
+	{
+		write(file, (uint16_t)changedKeys.size());
+		file.write(reinterpret_cast<const char*>(changedKeys.data()), changedKeys.size() * sizeof(uint16_t));
+	}
+	if(flags & ReplayButtons)
+		write(file, buttons);
+	if(flags & ReplayMouse)
+	{
+		write(file, input.X);
+		write(file, input.Y);
+	}
+	if(flags & ReplayScroll)
+		write(file, input.offset);
+	if(!file)
+		throw std::runtime_error("failed to write replay frame to " + path);
+
+	last = input;
+	frameCount++;
+}
+
+bool Replay::readFrame(double &frameTime, Input &input)
+{
+	uint8_t flags;
+	if(!read(file, frameTime) || !read(file, flags))
+		return false;
+	if(flags & ReplayKeys)
+	{
+		uint16_t count;
+		if(!read(file, count))
+			return false;
+		for(uint16_t i = 0; i < count; i++)
+		{
+			uint16_t key;
+			if(!read(file, key) || key >= 1024)
+				return false;
+			last.Keys[key] = !last.Keys[key];
+		}
+	}
+	if(flags & ReplayButtons)
+	{
+		uint8_t buttons;
+		if(!read(file, buttons))
+			return false;
+		for(unsigned int i = 0; i < 8; i++)
+			last.Buttons[i] = (buttons >> i) & 1;
+	}
+	if(flags & ReplayMouse)
+		if(!read(file, last.X) || !read(file, last.Y))
+			return false;
+	if(flags & ReplayScroll)
+		if(!read(file, last.offset))
+			return false;
+
+	input = last;
+	frameCount++;
+	return true;
+}
+
+} //namespace end
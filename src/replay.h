@@ -0,0 +1,52 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <string>
+#include <fstream>
+#include <vector>
+#include <stdint.h>
+
+#include "input.h"
+
+namespace gh
+{
+
+enum class ReplayMode
+{
+	Off,
+	Record,
+	Play,
+};
+
+//records the input and frame time of every frame, along with the run seed, so a run can be played back
+//exactly. Each frame only stores what changed from the last one. The file uses the machine's byte order
+class Replay
+{
+public:
+	Replay() {}
+	~Replay();
+	//sets the run seed, so call these before the app (and anything with a gh::Random) is made
+	void Record(std::string path);
+	void Play(std::string path);
+
+	//when recording, saves this frame. when playing, replaces them with the recorded frame.
+	//returns false once playback has run out of frames
+	bool Frame(double &frameTime, Input &input);
+	ReplayMode Mode() { return mode; }
+	unsigned int FrameCount() { return frameCount; }
+
+private:
+	void writeFrame(double frameTime, const Input &input);
+	bool readFrame(double &frameTime, Input &input);
+
+	ReplayMode mode = ReplayMode::Off;
+	std::fstream file;
+	std::string path;
+	Input last;
+	unsigned int frameCount = 0;
+	std::vector<uint16_t> changedKeys;
+};
+
+} //namespace end
+
+#endif
@@ -0,0 +1,84 @@
+#include "roomGraph.h"
+
+namespace gh
+{
+
+static float gapBetween(glm::vec4 a, glm::vec4 b)
+{
+	float x = std::max(a.x - (b.x + b.z), b.x - (a.x + a.z));
+	float y = std::max(a.y - (b.y + b.w), b.y - (a.y + a.w));
+	return std::max(x, y);
+}
+
+RoomGraph::RoomGraph(const std::vector<glm::vec4> &rooms, float adjacencyGap)
+{
+	this->rooms = rooms;
+	//sorted by left edge so each room only checks rooms starting before its right edge plus the gap
+	std::vector<unsigned int> order(rooms.size());
+	for(unsigned int i = 0; i < order.size(); i++)
+		order[i] = i;
+	std::sort(order.begin(), order.end(), [&rooms](unsigned int a, unsigned int b) {
+		return rooms[a].x < rooms[b].x || (rooms[a].x == rooms[b].x && a < b);
+	});
+	std::vector<std::vector<unsigned int>> adjacent(rooms.size());
+	for(unsigned int i = 0; i < order.size(); i++)
+	{
+		const glm::vec4 &a = rooms[order[i]];
+		for(unsigned int j = i + 1; j < order.size() && rooms[order[j]].x <= a.x + a.z + adjacencyGap; j++)
+			if(gapBetween(a, rooms[order[j]]) <= adjacencyGap)
+			{
+				adjacent[order[i]].push_back(order[j]);
+				adjacent[order[j]].push_back(order[i]);
+			}
+	}
+	neighbourStart.push_back(0);
+	for(auto &list: adjacent)
+	{
+		std::sort(list.begin(), list.end());
+		neighbourItems.insert(neighbourItems.end(), list.begin(), list.end());
+		neighbourStart.push_back((unsigned int)neighbourItems.size());
+	}
+}
+
+int RoomGraph::Find(glm::vec2 point, int hint) const
+{
+	if(hint >= 0 && hint < (int)rooms.size())
+	{
+		if(gh::contains(point, rooms[hint]))
+			return lowestContaining(point, hint);
+		for(auto n = NeighboursBegin(hint); n != NeighboursEnd(hint); n++)
+			if(gh::contains(point, rooms[*n]))
+				return lowestContaining(point, *n);
+	}
+	for(unsigned int i = 0; i < rooms.size(); i++)
+		if(gh::contains(point, rooms[i]))
+			return i;
+	return -1;
+}
+
+//any other room containing point overlaps this one, so is one of its neighbours
+int RoomGraph::lowestContaining(glm::vec2 point, int room) const
+{
+	for(auto n = NeighboursBegin(room); n != NeighboursEnd(room) && (int)*n < room; n++)
+		if(gh::contains(point, rooms[*n]))
+			return *n;
+	return room;
+}
+
+int RoomGraph::Nearest(glm::vec2 point) const
+{
+	int nearest = -1;
+	float best = 0;
+	for(unsigned int i = 0; i < rooms.size(); i++)
+	{
+		float gap = gapBetween(glm::vec4(point.x, point.y, 0, 0), rooms[i]);
+		if(nearest == -1 || gap < best)
+		{
+			nearest = i;
+			best = gap;
+		}
+	}
+	return nearest;
+}
+
+} //namespace end
@@ -0,0 +1,46 @@
+#ifndef ROOM_GRAPH_H
+#define ROOM_GRAPH_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "gamehelper.h"
+
+namespace gh
+{
+
+//rooms closer than this are connected, corridors between camera rooms are up to 3 tiles long
+const float ROOM_ADJACENCY_GAP = 96;
+
+//camera rooms with the rooms that overlap or are within the adjacency gap of each
+class RoomGraph
+{
+public:
+	RoomGraph() {}
+	RoomGraph(const std::vector<glm::vec4> &rooms, float adjacencyGap);
+
+	//lowest index room containing point, same as scanning every room in order.
+	//only the hint and its neighbours are checked when the point is in one of them, -1 for no room
+	int Find(glm::vec2 point, int hint) const;
+	//room with the closest edge to point
+	int Nearest(glm::vec2 point) const;
+
+	unsigned int Count() const { return (unsigned int)rooms.size(); }
+	glm::vec4 Room(int i) const { return i < 0 ? glm::vec4(0) : rooms[i]; }
+	//sorted, without the room itself
+	const unsigned int* NeighboursBegin(int i) const { return neighbourItems.data() + neighbourStart[i]; }
+	const unsigned int* NeighboursEnd(int i) const { return neighbourItems.data() + neighbourStart[i + 1]; }
+
+private:
+	int lowestContaining(glm::vec2 point, int room) const;
+
+	std::vector<glm::vec4> rooms;
+	std::vector<unsigned int> neighbourStart;
+	std::vector<unsigned int> neighbourItems;
+};
+
+} //namespace end
+
+#endif
@@ -0,0 +1,285 @@
+#include "spatialGrid.h"
+
+namespace gh
+{
+
+SpatialGrid::SpatialGrid(glm::vec4 area, float cellSize, const std::vector<glm::vec4> &staticRects)
+{
+	this->area = area;
+	this->cellSize = cellSize;
+	this->staticRects = staticRects;
+	cellsX = (unsigned int)std::ceil(area.z / cellSize);
+	cellsY = (unsigned int)std::ceil(area.w / cellSize);
+	if(cellsX == 0)
+		cellsX = 1;
+	if(cellsY == 0)
+		cellsY = 1;
+
+	//count rects per cell, then fill each cell's slice of the item list
+	staticCellStart.assign(cellsX * cellsY + 1, 0);
+	unsigned int sX, sY, eX, eY;
+	for(const auto &rect: staticRects)
+	{
+		cellRange(rect, sX, sY, eX, eY);
+		for(unsigned int y = sY; y <= eY; y++)
+			for(unsigned int x = sX; x <= eX; x++)
+				staticCellStart[y * cellsX + x + 1]++;
+	}
+	for(size_t i = 1; i < staticCellStart.size(); i++)
+		staticCellStart[i] += staticCellStart[i - 1];
+	staticCellItems.resize(staticCellStart.back());
+	std::vector<unsigned int> fill(staticCellStart.begin(), staticCellStart.end() - 1);
+	for(unsigned int i = 0; i < staticRects.size(); i++)
+	{
+		cellRange(staticRects[i], sX, sY, eX, eY);
+		for(unsigned int y = sY; y <= eY; y++)
+			for(unsigned int x = sX; x <= eX; x++)
+				staticCellItems[fill[y * cellsX + x]++] = i;
+	}
+}
+
+bool SpatialGrid::Colliding(glm::vec4 rect)
+{
+	if(staticRects.size() == 0)
+		return false;
+	unsigned int sX, sY, eX, eY;
+	cellRange(rect, sX, sY, eX, eY);
+	for(unsigned int y = sY; y <= eY; y++)
+		for(unsigned int x = sX; x <= eX; x++)
+		{
+			unsigned int cell = y * cellsX + x;
+			for(unsigned int i = staticCellStart[cell]; i < staticCellStart[cell + 1]; i++)
+				if(gh::colliding(staticRects[staticCellItems[i]], rect))
+					return true;
+		}
+	return false;
+}
+
+bool SpatialGrid::Sweep(glm::vec4 rect, glm::vec2 delta, SweepHit &hit)
+{
+	if(staticRects.size() == 0)
+		return false;
+	glm::vec4 bounds = gh::sweptRect(rect, delta);
+	bool found = false;
+	hit.time = 1;
+	float time;
+	glm::vec2 normal;
+	unsigned int sX, sY, eX, eY;
+	cellRange(bounds, sX, sY, eX, eY);
+	for(unsigned int y = sY; y <= eY; y++)
+		for(unsigned int x = sX; x <= eX; x++)
+		{
+			unsigned int cell = y * cellsX + x;
+			for(unsigned int i = staticCellStart[cell]; i < staticCellStart[cell + 1]; i++)
+			{
+				const glm::vec4 &wall = staticRects[staticCellItems[i]];
+				if(gh::sweep(rect, delta, wall, time, normal) && (!found || time < hit.time))
+				{
+					found = true;
+					hit.time = time;
+					hit.normal = normal;
+					hit.rect = wall;
+				}
+			}
+		}
+	return found;
+}
+
+bool SpatialGrid::MoveAndSlide(glm::vec4 &rect, glm::vec2 delta)
+{
+	bool collided = false;
+	SweepHit hit;
+	//sweeps can't see walls the rect is already inside, like after a spawn or a push
+	glm::vec4 start = rect;
+	glm::vec2 normal;
+	for(int i = 0; i < SWEEP_MAX_CONTACTS && pushOut(rect, normal); i++)
+	{
+		collided = true;
+		if(normal.x * delta.x < 0)
+			delta.x = 0;
+		if(normal.y * delta.y < 0)
+			delta.y = 0;
+	}
+	if(collided && Colliding(rect))
+	{
+		rect = start;
+		return true;
+	}
+	for(int i = 0; i < SWEEP_MAX_CONTACTS && delta != glm::vec2(0); i++)
+	{
+		if(!Sweep(rect, delta, hit))
+		{
+			rect.x += delta.x;
+			rect.y += delta.y;
+			return collided;
+		}
+		collided = true;
+		touch(rect, delta, hit);
+		delta *= 1 - hit.time;
+		if(hit.normal.x != 0)
+			delta.x = 0;
+		else
+			delta.y = 0;
+	}
+	return collided;
+}
+
+bool SpatialGrid::MoveAndReflect(glm::vec4 &rect, glm::vec2 delta, glm::vec2 &velocity)
+{
+	bool collided = false;
+	SweepHit hit;
+	glm::vec4 start = rect;
+	glm::vec2 normal;
+	for(int i = 0; i < SWEEP_MAX_CONTACTS && pushOut(rect, normal); i++)
+	{
+		collided = true;
+		if(normal.x * delta.x < 0)
+		{
+			delta.x = -delta.x;
+			velocity.x = -velocity.x;
+		}
+		if(normal.y * delta.y < 0)
+		{
+			delta.y = -delta.y;
+			velocity.y = -velocity.y;
+		}
+	}
+	if(collided && Colliding(rect))
+	{
+		rect = start;
+		return true;
+	}
+	for(int i = 0; i < SWEEP_MAX_CONTACTS && delta != glm::vec2(0); i++)
+	{
+		if(!Sweep(rect, delta, hit))
+		{
+			rect.x += delta.x;
+			rect.y += delta.y;
+			return collided;
+		}
+		collided = true;
+		touch(rect, delta, hit);
+		delta *= 1 - hit.time;
+		if(hit.normal.x != 0)
+		{
+			delta.x = -delta.x;
+			velocity.x = -velocity.x;
+		}
+		else
+		{
+			delta.y = -delta.y;
+			velocity.y = -velocity.y;
+		}
+	}
+	return collided;
+}
+
+//move to the contact, then place the hit side just off the wall
+void SpatialGrid::touch(glm::vec4 &rect, glm::vec2 delta, const SweepHit &hit)
+{
+	rect.x += delta.x * hit.time;
+	rect.y += delta.y * hit.time;
+	if(hit.normal.x < 0)
+		rect.x = hit.rect.x - rect.z - SWEEP_SKIN;
+	else if(hit.normal.x > 0)
+		rect.x = hit.rect.x + hit.rect.z + SWEEP_SKIN;
+	else if(hit.normal.y < 0)
+		rect.y = hit.rect.y - rect.w - SWEEP_SKIN;
+	else
+		rect.y = hit.rect.y + hit.rect.w + SWEEP_SKIN;
+}
+
+//moves rect out of the first wall it overlaps by the least distance, just off the wall like touch.
+//normal is the way it was pushed, false if it wasn't in a wall
+bool SpatialGrid::pushOut(glm::vec4 &rect, glm::vec2 &normal)
+{
+	if(staticRects.size() == 0)
+		return false;
+	unsigned int sX, sY, eX, eY;
+	cellRange(rect, sX, sY, eX, eY);
+	for(unsigned int y = sY; y <= eY; y++)
+		for(unsigned int x = sX; x <= eX; x++)
+		{
+			unsigned int cell = y * cellsX + x;
+			for(unsigned int i = staticCellStart[cell]; i < staticCellStart[cell + 1]; i++)
+			{
+				const glm::vec4 &wall = staticRects[staticCellItems[i]];
+				if(!gh::colliding(wall, rect))
+					continue;
+				float left = rect.x + rect.z - wall.x;
+				float right = wall.x + wall.z - rect.x;
+				float up = rect.y + rect.w - wall.y;
+				float down = wall.y + wall.w - rect.y;
+				float least = std::min(std::min(left, right), std::min(up, down));
+				if(least == left)
+				{
+					rect.x = wall.x - rect.z - SWEEP_SKIN;
+					normal = glm::vec2(-1, 0);
+				}
+				else if(least == right)
+				{
+					rect.x = wall.x + wall.z + SWEEP_SKIN;
+					normal = glm::vec2(1, 0);
+				}
+				else if(least == up)
+				{
+					rect.y = wall.y - rect.w - SWEEP_SKIN;
+					normal = glm::vec2(0, -1);
+				}
+				else
+				{
+					rect.y = wall.y + wall.w + SWEEP_SKIN;
+					normal = glm::vec2(0, 1);
+				}
+				return true;
+			}
+		}
+	return false;
+}
+
+void SpatialGrid::QueryStatic(glm::vec4 rect, std::vector<glm::vec4> &candidates)
+{
+	candidates.clear();
+	std::vector<unsigned int> ids;
+	QueryStaticIds(rect, ids);
+	for(auto id: ids)
+		candidates.push_back(staticRects[id]);
+}
+
+void SpatialGrid::QueryStaticIds(glm::vec4 rect, std::vector<unsigned int> &ids)
+{
+	ids.clear();
+	if(staticRects.size() == 0)
+		return;
+	unsigned int sX, sY, eX, eY;
+	cellRange(rect, sX, sY, eX, eY);
+	for(unsigned int y = sY; y <= eY; y++)
+		for(unsigned int x = sX; x <= eX; x++)
+		{
+			unsigned int cell = y * cellsX + x;
+			ids.insert(ids.end(), staticCellItems.begin() + staticCellStart[cell],
+						staticCellItems.begin() + staticCellStart[cell + 1]);
+		}
+	std::sort(ids.begin(), ids.end());
+	ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+}
+
+void SpatialGrid::cellRange(glm::vec4 rect, unsigned int &startX, unsigned int &startY, unsigned int &endX, unsigned int &endY)
+{
+	startX = cellCoord(rect.x, area.x, cellsX);
+	startY = cellCoord(rect.y, area.y, cellsY);
+	endX = cellCoord(rect.x + rect.z, area.x, cellsX);
+	endY = cellCoord(rect.y + rect.w, area.y, cellsY);
+}
+
+unsigned int SpatialGrid::cellCoord(float pos, float origin, unsigned int cellCount)
+{
+	float cell = std::floor((pos - origin) / cellSize);
+	if(cell < 0 || cellCount == 0)
+		return 0;
+	if(cell >= cellCount)
+		return cellCount - 1;
+	return (unsigned int)cell;
+}
+
+} //namespace end
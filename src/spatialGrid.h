@@ -0,0 +1,68 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <array>
+
+#include "gamehelper.h"
+
+namespace gh
+{
+
+const float SPATIAL_GRID_CELL_SIZE = 128;
+//gap kept between a moved rect and the wall it stopped at, so the next sweep starts outside it
+const float SWEEP_SKIN = 0.01f;
+const int SWEEP_MAX_CONTACTS = 4;
+
+//uniform grid over an area, static rects are binned once.
+//rects outside the area are binned into the border cells so are still found
+class SpatialGrid
+{
+public:
+	SpatialGrid() {}
+	SpatialGrid(glm::vec4 area, float cellSize, const std::vector<glm::vec4> &staticRects);
+
+	bool Colliding(glm::vec4 rect);
+	//earliest static rect touched moving rect by delta
+	bool Sweep(glm::vec4 rect, glm::vec2 delta, SweepHit &hit);
+	//moves rect by delta, stopping on walls and keeping the motion along them.
+	//a rect starting inside walls is pushed out first, and doesn't move if it can't be
+	bool MoveAndSlide(glm::vec4 &rect, glm::vec2 delta);
+	//moves rect by delta, reflecting delta and velocity off walls at the contact point, walls it starts in as well
+	bool MoveAndReflect(glm::vec4 &rect, glm::vec2 delta, glm::vec2 &velocity);
+	void QueryStatic(glm::vec4 rect, std::vector<glm::vec4> &candidates);
+	//indices into the static rects, sorted and without duplicates
+	void QueryStaticIds(glm::vec4 rect, std::vector<unsigned int> &ids);
+	//start x, start y, end x, end y of the cells rect is binned into
+	std::array<unsigned int, 4> Cells(glm::vec4 rect)
+	{
+		std::array<unsigned int, 4> cells;
+		cellRange(rect, cells[0], cells[1], cells[2], cells[3]);
+		return cells;
+	}
+
+	size_t staticCount() { return staticRects.size(); }
+
+private:
+	void touch(glm::vec4 &rect, glm::vec2 delta, const SweepHit &hit);
+	bool pushOut(glm::vec4 &rect, glm::vec2 &normal);
+	void cellRange(glm::vec4 rect, unsigned int &startX, unsigned int &startY, unsigned int &endX, unsigned int &endY);
+	unsigned int cellCoord(float pos, float origin, unsigned int cellCount);
+
+	glm::vec4 area = glm::vec4(0);
+	float cellSize = SPATIAL_GRID_CELL_SIZE;
+	unsigned int cellsX = 0;
+	unsigned int cellsY = 0;
+
+	std::vector<glm::vec4> staticRects;
+	std::vector<unsigned int> staticCellStart;
+	std::vector<unsigned int> staticCellItems;
+};
+
+} //namespace end
+
+#endif
@@ -0,0 +1,61 @@
+#include "stressScenario.h"
+
+#include <random>
+
+//open tiles with a free tile on every side, so larger sprites don't start inside a wall
+static void openTiles(glm::vec4 area, const TileOccupancy &occupancy, std::vector<glm::vec2> &tiles)
+{
+	glm::vec2 tileSize = occupancy.getTileSize();
+	int startX = std::max((int)(area.x / tileSize.x) + 1, occupancy.getOriginX() + 1);
+	int startY = std::max((int)(area.y / tileSize.y) + 1, occupancy.getOriginY() + 1);
+	int endX = std::min((int)((area.x + area.z) / tileSize.x) - 1, occupancy.getOriginX() + (int)occupancy.getWidth() - 1);
+	int endY = std::min((int)((area.y + area.w) / tileSize.y) - 1, occupancy.getOriginY() + (int)occupancy.getHeight() - 1);
+	for(int y = startY; y < endY; y++)
+		for(int x = startX; x < endX; x++)
+		{
+			glm::vec4 around = glm::vec4((x - 1) * tileSize.x, (y - 1) * tileSize.y, tileSize.x * 3, tileSize.y * 3);
+			if(!occupancy.SolidIn(around) && !occupancy.GapIn(around))
+				tiles.push_back(glm::vec2(x * tileSize.x, y * tileSize.y));
+		}
+}
+
+StressCounts SpawnStress(StressCounts counts, unsigned int seed, glm::vec2 around,
+			const gh::RoomGraph &rooms, const TileOccupancy &occupancy, EntityStore &entities, BulletPool &bullets)
+{
+	std::vector<glm::vec2> tiles;
+	int room = rooms.Find(around, -1);
+	if(room == -1 && rooms.Count() > 0)
+		room = rooms.Nearest(around);
+	if(room == -1)
+	{
+		glm::vec2 tileSize = occupancy.getTileSize();
+		openTiles(glm::vec4(occupancy.getOriginX() * tileSize.x, occupancy.getOriginY() * tileSize.y,
+					occupancy.getWidth() * tileSize.x, occupancy.getHeight() * tileSize.y), occupancy, tiles);
+	}
+	else
+	{
+		openTiles(rooms.Room(room), occupancy, tiles);
+		for(auto n = rooms.NeighboursBegin(room); n != rooms.NeighboursEnd(room); n++)
+			openTiles(rooms.Room(*n), occupancy, tiles);
+	}
+	StressCounts spawned;
+	if(tiles.size() == 0)
+		return spawned;
+
+	std::mt19937 random(seed);
+	std::uniform_int_distribution<size_t> tile(0, tiles.size() - 1);
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+	for(; spawned.walkers < counts.walkers; spawned.walkers++)
+		entities.Spawn(Walker, tiles[tile(random)]);
+	for(; spawned.scientists < counts.scientists; spawned.scientists++)
+		entities.Spawn(Scientist, tiles[tile(random)]);
+	for(; spawned.doors < counts.doors; spawned.doors++)
+		entities.Spawn(Door, tiles[tile(random)]);
+	for(; spawned.bullets < counts.bullets; spawned.bullets++)
+	{
+		float a = angle(random);
+		if(!bullets.Spawn(tiles[tile(random)], glm::vec2(std::cos(a), std::sin(a)) * 0.1f))
+			break;
+	}
+	return spawned;
+}
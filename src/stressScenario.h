@@ -0,0 +1,37 @@
+#ifndef STRESS_SCENARIO_H
+#define STRESS_SCENARIO_H
+
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "entities.h"
+#include "bullet.h"
+#include "roomGraph.h"
+#include "tileOccupancy.h"
+
+const unsigned int STRESS_SEED = 2022;
+
+//how a stress run's total is split between walkers, scientists, doors and bullets
+struct StressCounts
+{
+	StressCounts() {}
+	StressCounts(unsigned int total)
+	{
+		walkers = total / 2;
+		scientists = total / 5;
+		doors = total / 10;
+		bullets = total - walkers - scientists - doors;
+	}
+	unsigned int walkers = 0;
+	unsigned int scientists = 0;
+	unsigned int doors = 0;
+	unsigned int bullets = 0;
+};
+
+//adds to the map's own spawns on open tiles of the room around a point and its neighbours,
+//so everything stays awake. The layout only depends on the seed. returns what was spawned,
+//bullets stop when the pool is full
+StressCounts SpawnStress(StressCounts counts, unsigned int seed, glm::vec2 around,
+			const gh::RoomGraph &rooms, const TileOccupancy &occupancy, EntityStore &entities, BulletPool &bullets);
+
+#endif
@@ -0,0 +1,56 @@
+#include "sweepPrune.h"
+
+#include <algorithm>
+
+namespace gh
+{
+
+void SweepAndPrune::Update(const std::vector<glm::vec4> &rects)
+{
+	this->rects = rects;
+	//sweep along the axis the rects are spread over most, fewer rects share a slice of it
+	float sum[2] = { 0, 0 };
+	float sumSq[2] = { 0, 0 };
+	for(const auto &r: rects)
+		for(int a = 0; a < 2; a++)
+		{
+			float mid = r[a] + r[a + 2] * 0.5f;
+			sum[a] += mid;
+			sumSq[a] += mid * mid;
+		}
+	float n = rects.size() > 0 ? (float)rects.size() : 1.0f;
+	axis = sumSq[1] / n - (sum[1] / n) * (sum[1] / n) > sumSq[0] / n - (sum[0] / n) * (sum[0] / n) ? 1 : 0;
+
+	order.resize(rects.size());
+	for(unsigned int i = 0; i < order.size(); i++)
+		order[i] = i;
+	//ties by index, so the pairs come out in the same order every run
+	int axis = this->axis;
+	std::sort(order.begin(), order.end(), [&rects, axis](unsigned int a, unsigned int b) {
+		return rects[a][axis] < rects[b][axis] || (rects[a][axis] == rects[b][axis] && a < b);
+	});
+}
+
+void SweepAndPrune::Pairs(std::vector<std::pair<unsigned int, unsigned int>> &pairs)
+{
+	pairs.clear();
+	int other = 1 - axis;
+	for(unsigned int i = 0; i < order.size(); i++)
+	{
+		const glm::vec4 &a = rects[order[i]];
+		float max = a[axis] + a[axis + 2];
+		for(unsigned int j = i + 1; j < order.size() && rects[order[j]][axis] < max; j++)
+		{
+			const glm::vec4 &b = rects[order[j]];
+			if(a[other] < b[other] + b[other + 2] && a[other] + a[other + 2] > b[other] && b[axis] + b[axis + 2] > a[axis])
+			{
+				if(order[i] < order[j])
+					pairs.push_back(std::pair<unsigned int, unsigned int>(order[i], order[j]));
+				else
+					pairs.push_back(std::pair<unsigned int, unsigned int>(order[j], order[i]));
+			}
+		}
+	}
+}
+
+} //namespace end
@@ -0,0 +1,31 @@
+#ifndef SWEEP_PRUNE_H
+#define SWEEP_PRUNE_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <utility>
+
+namespace gh
+{
+
+//broad phase that sorts rects along one axis and sweeps for overlaps, O(n log n) per update,
+//then the sweep costs the rects sharing a slice of that axis, worst case O(n^2) when they all do.
+//rect indices aren't stable between ticks (bullets are swap removed), so the order is sorted from scratch
+class SweepAndPrune
+{
+public:
+	//rects are identified by their index, the count may change between updates
+	void Update(const std::vector<glm::vec4> &rects);
+	//pairs (a < b) whose rects overlap on both axes, same edges as gh::colliding
+	void Pairs(std::vector<std::pair<unsigned int, unsigned int>> &pairs);
+
+private:
+	std::vector<glm::vec4> rects;
+	std::vector<unsigned int> order;
+	//0 for x, 1 for y
+	int axis = 0;
+};
+
+} //namespace end
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef SYSTEM_TIMES_H
+#define SYSTEM_TIMES_H
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <array>
+
+//#define TIME_SYSTEMS
+#ifdef HEADLESS
+#define TIME_SYSTEMS
+#endif
+
+namespace gh
+{
+
+enum class SimSystem
+{
+	Messages,
+	Player,
+	Triggers,
+	Enemies,
+	EnemyHits,
+	Bullets,
+	BulletHits,
+	Camera,
+	Respawn,
+	Draw,
+	Count,
+};
+
+const char* const SIM_SYSTEM_NAMES[(int)SimSystem::Count] = {
+	"messages", "player", "triggers", "enemies", "enemy hits", "bullets", "bullet hits", "camera", "respawn",
+	"draw submit",
+};
+
+//adds up the time spent in each system of a tick. starting a system stops the last one.
+//does nothing unless TIME_SYSTEMS is defined
+class SystemTimes
+{
+public:
+	SystemTimes()
+	{
+		totals.fill(0.0);
+	}
+
+	void Start(SimSystem system)
+	{
+#ifdef TIME_SYSTEMS
+		auto now = std::chrono::steady_clock::now();
+		stop(now);
+		current = (int)system;
+		started = now;
+#endif
+	}
+
+	void Stop()
+	{
+#ifdef TIME_SYSTEMS
+		stop(std::chrono::steady_clock::now());
+#endif
+	}
+
+	void Print(unsigned int ticks)
+	{
+#ifdef TIME_SYSTEMS
+		if(ticks == 0)
+			return;
+		double total = 0;
+		for(double t: totals)
+			total += t;
+		std::cout << "system times over " << ticks << " ticks:" << std::endl;
+		for(unsigned int i = 0; i < totals.size(); i++)
+			std::cout << std::setw(12) << SIM_SYSTEM_NAMES[i] << ": "
+				<< std::setw(10) << std::fixed << std::setprecision(3) << totals[i] << " ms total, "
+				<< std::setw(8) << (totals[i] * 1000.0) / ticks << " us per tick, "
+				<< std::setw(5) << std::setprecision(1) << (total > 0 ? totals[i] / total * 100.0 : 0.0) << "%" << std::endl;
+		std::cout << std::setw(12) << "total" << ": " << std::setw(10) << std::setprecision(3) << total << " ms total, "
+			<< std::setw(8) << (total * 1000.0) / ticks << " us per tick" << std::endl;
+#endif
+	}
+
+private:
+	void stop(std::chrono::steady_clock::time_point now)
+	{
+		if(current < 0)
+			return;
+		totals[current] += std::chrono::duration<double, std::milli>(now - started).count();
+		current = -1;
+	}
+
+	std::array<double, (size_t)SimSystem::Count> totals;
+	int current = -1;
+	std::chrono::steady_clock::time_point started;
+};
+
+} //namespace end
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef TILE_OCCUPANCY_H
+#define TILE_OCCUPANCY_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cmath>
+#include <limits>
+
+//per tile solid and gap bits of a map, with summed counts so an area query is O(1).
+//origin is the tile the bits start at, so a streamed map can hold just the area around the player,
+//tiles outside are open
+class TileOccupancy
+{
+public:
+	TileOccupancy() {}
+	TileOccupancy(unsigned int width, unsigned int height, glm::vec2 tileSize,
+				const std::vector<bool> &solid, const std::vector<bool> &gap, int originX = 0, int originY = 0)
+	{
+		this->width = width;
+		this->height = height;
+		this->tileSize = tileSize;
+		this->originX = originX;
+		this->originY = originY;
+		this->solid = solid;
+		this->gap = gap;
+		sumCounts(solid, solidSum);
+		sumCounts(gap, gapSum);
+	}
+	//bits for every tile the rects overlap over the tiles covering area, so a rect SolidIn and GapIn both
+	//miss is clear of all of them. Rects outside area are only partly marked, check Holds first
+	TileOccupancy(glm::vec4 area, glm::vec2 tileSize, const std::vector<glm::vec4> &solidRects, const std::vector<glm::vec4> &gapRects)
+	{
+		this->tileSize = tileSize;
+		originX = (int)std::floor(area.x / tileSize.x);
+		originY = (int)std::floor(area.y / tileSize.y);
+		width = (unsigned int)std::ceil((area.x + area.z) / tileSize.x) - originX;
+		height = (unsigned int)std::ceil((area.y + area.w) / tileSize.y) - originY;
+		markRects(solidRects, solid);
+		markRects(gapRects, gap);
+		sumCounts(solid, solidSum);
+		sumCounts(gap, gapSum);
+	}
+
+	bool Solid(int x, int y) const
+	{
+		x -= originX;
+		y -= originY;
+		if(x < 0 || y < 0 || x >= (int)width || y >= (int)height)
+			return false;
+		return solid[y * width + x];
+	}
+
+	bool Gap(int x, int y) const
+	{
+		x -= originX;
+		y -= originY;
+		if(x < 0 || y < 0 || x >= (int)width || y >= (int)height)
+			return false;
+		return gap[y * width + x];
+	}
+
+	bool SolidAt(glm::vec2 point) const
+	{
+		return Solid((int)std::floor(point.x / tileSize.x), (int)std::floor(point.y / tileSize.y));
+	}
+
+	//any solid tile touched by rect
+	bool SolidIn(glm::vec4 rect) const
+	{
+		return areaCount(solidSum, rect) > 0;
+	}
+
+	bool GapIn(glm::vec4 rect) const
+	{
+		return areaCount(gapSum, rect) > 0;
+	}
+
+	//rect is within the tiles held, outside them nothing is known
+	bool Holds(glm::vec4 rect) const
+	{
+		return rect.x >= originX * tileSize.x && rect.y >= originY * tileSize.y
+			&& rect.x + rect.z <= (originX + (int)width) * tileSize.x
+			&& rect.y + rect.w <= (originY + (int)height) * tileSize.y;
+	}
+
+	//walks the tiles along the line (Amanatides & Woo DDA), the tile from starts in is skipped
+	bool LineOfSight(glm::vec2 from, glm::vec2 to) const
+	{
+		if(width == 0 || height == 0)
+			return true;
+		glm::vec2 start = from / tileSize;
+		glm::vec2 dir = to / tileSize - start;
+		int x = (int)std::floor(start.x);
+		int y = (int)std::floor(start.y);
+		int stepX = dir.x > 0 ? 1 : -1;
+		int stepY = dir.y > 0 ? 1 : -1;
+		const float inf = std::numeric_limits<float>::infinity();
+		float deltaX = dir.x != 0 ? std::abs(1.0f / dir.x) : inf;
+		float deltaY = dir.y != 0 ? std::abs(1.0f / dir.y) : inf;
+		float nextX = dir.x != 0 ? (dir.x > 0 ? x + 1 - start.x : start.x - x) * deltaX : inf;
+		float nextY = dir.y != 0 ? (dir.y > 0 ? y + 1 - start.y : start.y - y) * deltaY : inf;
+		while(true)
+		{
+			if(nextX < nextY)
+			{
+				if(nextX > 1)
+					return true;
+				x += stepX;
+				nextX += deltaX;
+			}
+			else
+			{
+				if(nextY > 1)
+					return true;
+				y += stepY;
+				nextY += deltaY;
+			}
+			if(Solid(x, y))
+				return false;
+		}
+	}
+
+	unsigned int getWidth() const { return width; }
+	int getOriginX() const { return originX; }
+	int getOriginY() const { return originY; }
+	unsigned int getHeight() const { return height; }
+	glm::vec2 getTileSize() const { return tileSize; }
+
+private:
+	void sumCounts(const std::vector<bool> &bits, std::vector<unsigned int> &sum)
+	{
+		sum.assign((width + 1) * (height + 1), 0);
+		for(unsigned int y = 0; y < height; y++)
+			for(unsigned int x = 0; x < width; x++)
+				sum[(y + 1) * (width + 1) + x + 1] = (bits[y * width + x] ? 1 : 0)
+						+ sum[y * (width + 1) + x + 1]
+						+ sum[(y + 1) * (width + 1) + x]
+						- sum[y * (width + 1) + x];
+	}
+
+	void markRects(const std::vector<glm::vec4> &rects, std::vector<bool> &bits)
+	{
+		bits.assign(width * height, false);
+		unsigned int sX, sY, eX, eY;
+		for(const auto &rect: rects)
+		{
+			tileRange(rect, sX, sY, eX, eY);
+			for(unsigned int y = sY; y < eY; y++)
+				for(unsigned int x = sX; x < eX; x++)
+					bits[y * width + x] = true;
+		}
+	}
+
+	//tiles the open rect overlaps, same edges as gh::colliding
+	void tileRange(glm::vec4 rect, unsigned int &sX, unsigned int &sY, unsigned int &eX, unsigned int &eY) const
+	{
+		sX = clampTile(std::floor(rect.x / tileSize.x) - originX, width);
+		sY = clampTile(std::floor(rect.y / tileSize.y) - originY, height);
+		eX = clampTile(std::ceil((rect.x + rect.z) / tileSize.x) - originX, width);
+		eY = clampTile(std::ceil((rect.y + rect.w) / tileSize.y) - originY, height);
+	}
+
+	unsigned int areaCount(const std::vector<unsigned int> &sum, glm::vec4 rect) const
+	{
+		if(width == 0 || height == 0)
+			return 0;
+		unsigned int sX, sY, eX, eY;
+		tileRange(rect, sX, sY, eX, eY);
+		if(sX >= eX || sY >= eY)
+			return 0;
+		return sum[eY * (width + 1) + eX] - sum[sY * (width + 1) + eX]
+				- sum[eY * (width + 1) + sX] + sum[sY * (width + 1) + sX];
+	}
+
+	static unsigned int clampTile(float tile, unsigned int tileCount)
+	{
+		if(tile < 0)
+			return 0;
+		if(tile > tileCount)
+			return tileCount;
+		return (unsigned int)tile;
+	}
+
+	unsigned int width = 0;
+	unsigned int height = 0;
+	int originX = 0;
+	int originY = 0;
+	glm::vec2 tileSize = glm::vec2(1);
+	std::vector<bool> solid;
+	std::vector<bool> gap;
+	std::vector<unsigned int> solidSum;
+	std::vector<unsigned int> gapSum;
+};
+
+#endif
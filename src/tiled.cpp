@@ -1,5 +1,9 @@
 #include "tiled.h"
 
+#include "vulkan-render/stb_image.h"
+
+#include <memory>
+
 namespace tiled
 {
 
@@ -10,6 +14,7 @@ Tileset::Tileset(std::string filename)
 	else if(filename.substr(filename.length() - 3, 3) != "tsx")
 		throw std::runtime_error("failed to load text file at " + filename + " \ntilemap filename is not .tsx");
 
+	this->source = filename;
 	char* tilesetText = loadTextFile(filename);
 	if(tilesetText == nullptr)
 		throw std::runtime_error("failed to load text file at " + filename);
@@ -40,7 +45,7 @@ Tileset::Tileset(std::string filename)
 		lastpos = 0;
 	this->imageSource = TILED_TEXTURE_LOCATION + imageSource.substr(lastpos);
 
-	delete tilesetText;
+	delete[] tilesetText;
 }
 
 
@@ -50,13 +55,14 @@ Map::Map(std::string filename)
 		throw std::runtime_error("failed to load text file at " + filename + " \nmap filename is invalid");
 	else if(filename.substr(filename.length() - 3, 3) != "tmx")
 		throw std::runtime_error("failed to load text file at " + filename + " \nmap filename is not .tmx");
-	char* MapText = loadTextFile(filename);
+	//rapidxml parses in place, so the text lives until the constructor returns or throws
+	std::unique_ptr<char[]> MapText(loadTextFile(filename));
 
 	if(MapText == nullptr)
 		throw std::runtime_error("failed to load text file at " + filename);
 
 	rapidxml::xml_document<> mapXML;
-	mapXML.parse<0>(MapText);
+	mapXML.parse<0>(MapText.get());
 	auto mapInfo = mapXML.first_node("map");
 	if(mapInfo == nullptr)
 		throw std::runtime_error("map at " + filename + " has no map node");
@@ -65,6 +71,8 @@ Map::Map(std::string filename)
 	this->height = std::atoi(mapInfo->first_attribute("height")->value());
 	this->tileWidth = std::atoi(mapInfo->first_attribute("tilewidth")->value());
 	this->tileHeight = std::atoi(mapInfo->first_attribute("tileheight")->value());
+	auto infiniteAttrib = mapInfo->first_attribute("infinite");
+	this->infinite = infiniteAttrib != nullptr && std::string(infiniteAttrib->value()) == "1";
 
 	auto mapProps = mapInfo->first_node("properties");
 	if(mapProps)
@@ -84,22 +92,21 @@ Map::Map(std::string filename)
 		}
 	}
 
-	totalTiles = 0;
-	
+	//tilesets and layer data are parsed as jobs, the map text is kept until they finish.
+	//everything that can throw is checked before the first job is queued, the jobs point into these lists
+	gh::JobCounter parsing;
+	std::vector<std::string> encodings;
+	std::vector<std::string> compressions;
 	for(auto tilesetInfo = mapInfo->first_node("tileset"); tilesetInfo; tilesetInfo = tilesetInfo->next_sibling("tileset"))
 	{
 		std::string tilesetInfoLoc = tilesetInfo->first_attribute("source")->value();
 		size_t lastpos = tilesetInfoLoc.find_last_of('/');
 		if(lastpos == std::string::npos)
 			lastpos = 0;
-		tilesets.push_back(Tileset(TILEMAP_LOCATION + tilesetInfoLoc.substr(lastpos)));
-
+		tilesets.push_back(Tileset());
 		tilesets.back().firstTileID = std::atoi(tilesetInfo->first_attribute("firstgid")->value());
-		if(tilesets.back().tileWidth != this->tileWidth || tilesets.back().tileHeight != this->tileHeight)
-			throw std::runtime_error("tileset tile dimentions do not match map tile dimentions");
-		totalTiles += tilesets.back().tileCount;
+		tilesets.back().source = TILEMAP_LOCATION + tilesetInfoLoc.substr(lastpos);
 	}
-
 	for(auto layerInfo = mapInfo->first_node("layer"); layerInfo; layerInfo = layerInfo->next_sibling("layer"))
 	{
 		layers.push_back(Layer());
@@ -112,30 +119,75 @@ Map::Map(std::string filename)
 		auto dataNode = layerInfo->first_node("data");
 		if(dataNode == nullptr)
 			throw std::runtime_error("layer of map at " + filename + " has no data node");
-
-		std::string currentNum = "";
-		for(size_t i = 0; i < dataNode->value_size(); i++)
+		auto encodingAttrib = dataNode->first_attribute("encoding");
+		auto compressionAttrib = dataNode->first_attribute("compression");
+		std::string encoding = encodingAttrib != nullptr ? encodingAttrib->value() : "";
+		std::string compression = compressionAttrib != nullptr ? compressionAttrib->value() : "";
+		if(encoding != "csv" && encoding != "base64")
+			throw std::runtime_error("layer of map at " + filename + " has unsupported encoding \"" + encoding
+				+ "\", use csv or base64");
+		if(compression != "" && compression != "zlib" && compression != "gzip")
+			throw std::runtime_error("layer of map at " + filename + " has unsupported compression \"" + compression
+				+ "\", use zlib, gzip or none");
+		encodings.push_back(encoding);
+		compressions.push_back(compression);
+	}
+	for(auto &tileset: tilesets)
+	{
+		Tileset *t = &tileset;
+		gh::JobSystem::Get().Run([t] {
+			unsigned int firstTileID = t->firstTileID;
+			*t = Tileset(t->source);
+			t->firstTileID = firstTileID;
+		}, &parsing);
+	}
+	unsigned int layerIndex = 0;
+	for(auto layerInfo = mapInfo->first_node("layer"); layerInfo; layerInfo = layerInfo->next_sibling("layer"))
+	{
+		auto dataNode = layerInfo->first_node("data");
+		std::string encoding = encodings[layerIndex];
+		std::string compression = compressions[layerIndex];
+		Layer *layer = &layers[layerIndex++];
+		unsigned int tiles = this->width * this->height;
+		if(infinite)
 		{
-			switch(dataNode->value()[i])
-			{
-				case '\n':
-					break;
-				case ',':
-					if(currentNum.size() == 0)
-						throw std::runtime_error("layer of map at " + filename + " has blank tile data");
-					layers.back().data.push_back(std::stoi(currentNum));	
-					currentNum = "";
-					break;
-				default:
-					currentNum += dataNode->value()[i];
-					break;
-			}
+			gh::JobSystem::Get().Run([dataNode, layer, filename, encoding, compression] {
+				for(auto chunkInfo = dataNode->first_node("chunk"); chunkInfo; chunkInfo = chunkInfo->next_sibling("chunk"))
+				{
+					layer->chunks.push_back(LayerChunk());
+					LayerChunk &chunk = layer->chunks.back();
+					chunk.x = std::atoi(chunkInfo->first_attribute("x")->value());
+					chunk.y = std::atoi(chunkInfo->first_attribute("y")->value());
+					chunk.width = std::atoi(chunkInfo->first_attribute("width")->value());
+					chunk.height = std::atoi(chunkInfo->first_attribute("height")->value());
+					unsigned int chunkTiles = chunk.width * chunk.height;
+					if(encoding == "csv")
+						parseLayerData(chunkInfo->value(), chunkInfo->value_size(), chunk.data, chunkTiles, filename);
+					else
+						decodeLayerData(chunkInfo->value(), chunkInfo->value_size(), compression, chunk.data, chunkTiles, filename);
+					if(chunk.data.size() != chunkTiles)
+						throw std::runtime_error("chunk of map at " + filename + " has different dimentions than its size");
+				}
+			}, &parsing);
+			continue;
 		}
-		if(currentNum.size() == 0)
-			throw std::runtime_error("layer of map at " + filename + " has blank tile data");
-		layers.back().data.push_back(std::stoi(currentNum));
-		if(layers.back().data.size() != this->width * this->height)
-			throw std::runtime_error("layer of map at " + filename + " has different dimentions than map");
+		gh::JobSystem::Get().Run([dataNode, layer, tiles, filename, encoding, compression] {
+			if(encoding == "csv")
+				parseLayerData(dataNode->value(), dataNode->value_size(), layer->data, tiles, filename);
+			else
+				decodeLayerData(dataNode->value(), dataNode->value_size(), compression, layer->data, tiles, filename);
+			if(layer->data.size() != tiles)
+				throw std::runtime_error("layer of map at " + filename + " has different dimentions than map");
+		}, &parsing);
+	}
+	gh::JobSystem::Get().Wait(parsing);
+
+	totalTiles = 0;
+	for(const auto &tileset: tilesets)
+	{
+		if(tileset.tileWidth != this->tileWidth || tileset.tileHeight != this->tileHeight)
+			throw std::runtime_error("tileset tile dimentions do not match map tile dimentions");
+		totalTiles += tileset.tileCount;
 	}
 
 	for(auto objGroupInfo = mapInfo->first_node("objectgroup"); objGroupInfo; objGroupInfo = objGroupInfo->next_sibling("objectgroup"))
@@ -194,7 +246,204 @@ Map::Map(std::string filename)
 		imgLayer.back().source = TILED_IMAGE_LOCATION + imageSource.substr(lastpos);
 	}
 
-	delete MapText;
+	if(infinite)
+		shiftToChunkBounds();
+
+}
+
+//infinite maps can have chunks at negative tiles, so the map is made to start at the first tile of any chunk
+//and sized to cover them all, the width and height in the tmx are ignored
+void Map::shiftToChunkBounds()
+{
+	bool any = false;
+	int minX = 0, minY = 0, maxX = 0, maxY = 0;
+	for(const auto &layer: layers)
+		for(const auto &chunk: layer.chunks)
+		{
+			int endX = chunk.x + (int)chunk.width;
+			int endY = chunk.y + (int)chunk.height;
+			minX = any ? std::min(minX, chunk.x) : chunk.x;
+			minY = any ? std::min(minY, chunk.y) : chunk.y;
+			maxX = any ? std::max(maxX, endX) : endX;
+			maxY = any ? std::max(maxY, endY) : endY;
+			any = true;
+		}
+	originX = minX;
+	originY = minY;
+	width = maxX - minX;
+	height = maxY - minY;
+	for(auto &layer: layers)
+		for(auto &chunk: layer.chunks)
+		{
+			chunk.x -= originX;
+			chunk.y -= originY;
+		}
+	double offsetX = (double)originX * tileWidth;
+	double offsetY = (double)originY * tileHeight;
+	for(auto &group: objectGroups)
+		for(auto &obj: group.objs)
+		{
+			obj.x -= offsetX;
+			obj.y -= offsetY;
+		}
+	for(auto &image: imgLayer)
+	{
+		image.x -= offsetX;
+		image.y -= offsetY;
+	}
+}
+
+//converts the csv in place straight into data, which is sized to the map once,
+//so a layer costs one allocation however many tiles it has.
+//anything at or below a space counts as whitespace, which covers tiled's line breaks
+void parseLayerData(const char* text, size_t size, std::vector<unsigned int> &data, size_t tiles, const std::string &filename)
+{
+	data.resize(tiles);
+	unsigned int* out = tiles > 0 ? &data[0] : nullptr;
+	size_t count = 0;
+	const char* c = text;
+	const char* end = text + size;
+	while(true)
+	{
+		while(c < end && (unsigned char)*c <= ' ')
+			c++;
+		const char* start = c;
+		unsigned long long value = 0;
+		unsigned char digit;
+		while(c < end && (digit = (unsigned char)(*c - '0')) < 10)
+		{
+			value = value * 10 + digit;
+			c++;
+		}
+		if(c == start)
+		{
+			if(c < end && *c != ',')
+				throw std::runtime_error("layer of map at " + filename + " has tile data that isn't csv");
+			throw std::runtime_error("layer of map at " + filename + " has blank tile data");
+		}
+		if(c - start > 10 || value > INT_MAX)
+			throw std::runtime_error("layer of map at " + filename + " has a tile id that is out of range");
+		if(count == tiles)
+			throw std::runtime_error("layer of map at " + filename + " has different dimentions than map");
+		out[count++] = (unsigned int)value;
+		if(c < end && *c == ',')
+		{
+			c++;
+			continue;
+		}
+		while(c < end && (unsigned char)*c <= ' ')
+			c++;
+		if(c == end)
+			break;
+		if(*c != ',')
+			throw std::runtime_error("layer of map at " + filename + " has tile data that isn't csv");
+		c++;
+	}
+	data.resize(count);
+}
+
+static int base64Value(char c)
+{
+	if(c >= 'A' && c <= 'Z')
+		return c - 'A';
+	if(c >= 'a' && c <= 'z')
+		return c - 'a' + 26;
+	if(c >= '0' && c <= '9')
+		return c - '0' + 52;
+	if(c == '+')
+		return 62;
+	if(c == '/')
+		return 63;
+	return -1;
+}
+
+//skips the gzip header so the deflate data after it can be inflated, returns the header size
+static size_t gzipHeaderSize(const unsigned char* bytes, size_t size, const std::string &filename)
+{
+	const unsigned char FHCRC = 0x02, FEXTRA = 0x04, FNAME = 0x08, FCOMMENT = 0x10;
+	if(size < 18 || bytes[0] != 0x1f || bytes[1] != 0x8b || bytes[2] != 8)
+		throw std::runtime_error("layer of map at " + filename + " has invalid gzip data");
+	unsigned char flags = bytes[3];
+	size_t pos = 10;
+	if(flags & FEXTRA)
+		pos += 2 + (bytes[pos] | (bytes[pos + 1] << 8));
+	if(flags & FNAME)
+		while(pos < size && bytes[pos++] != 0);
+	if(flags & FCOMMENT)
+		while(pos < size && bytes[pos++] != 0);
+	if(flags & FHCRC)
+		pos += 2;
+	//the crc and size trail the deflate data, they are left on as stb reads a little past the end of it
+	if(pos + 8 > size)
+		throw std::runtime_error("layer of map at " + filename + " has invalid gzip data");
+	return pos;
+}
+
+//base64 tile ids are little endian 32 bit ints, optionally zlib or gzip compressed.
+//the inflate is stb_image's, which is already built for png loading
+void decodeLayerData(const char* text, size_t size, std::string compression, std::vector<unsigned int> &data, size_t tiles, const std::string &filename)
+{
+	std::vector<unsigned char> bytes;
+	bytes.reserve(size / 4 * 3);
+	unsigned int bits = 0;
+	int bitCount = 0;
+	for(size_t i = 0; i < size; i++)
+	{
+		if((unsigned char)text[i] <= ' ')
+			continue;
+		if(text[i] == '=')
+			break;
+		int value = base64Value(text[i]);
+		if(value < 0)
+			throw std::runtime_error("layer of map at " + filename + " has tile data that isn't base64");
+		bits = (bits << 6) | value;
+		bitCount += 6;
+		if(bitCount >= 8)
+		{
+			bitCount -= 8;
+			bytes.push_back((unsigned char)(bits >> bitCount));
+		}
+	}
+
+	const unsigned char* tileBytes = bytes.data();
+	size_t tileByteCount = bytes.size();
+	char* inflated = nullptr;
+	if(compression != "")
+	{
+		size_t start = 0;
+		size_t length = bytes.size();
+		if(compression == "gzip")
+		{
+			start = gzipHeaderSize(bytes.data(), bytes.size(), filename);
+			length = bytes.size() - start;
+		}
+		int inflatedSize = 0;
+		inflated = stbi_zlib_decode_malloc_guesssize_headerflag((const char*)bytes.data() + start, (int)length,
+					(int)(tiles * 4), &inflatedSize, compression == "zlib");
+		if(inflated == nullptr)
+			throw std::runtime_error("layer of map at " + filename + " has " + compression + " data that failed to inflate");
+		tileBytes = (const unsigned char*)inflated;
+		tileByteCount = inflatedSize;
+	}
+
+	if(tileByteCount != tiles * 4)
+	{
+		free(inflated);
+		throw std::runtime_error("layer of map at " + filename + " has different dimentions than map");
+	}
+	data.resize(tiles);
+	for(size_t i = 0; i < tiles; i++)
+	{
+		const unsigned char* tile = tileBytes + i * 4;
+		unsigned int id = tile[0] | (tile[1] << 8) | (tile[2] << 16) | ((unsigned int)tile[3] << 24);
+		if(id > INT_MAX)
+		{
+			free(inflated);
+			throw std::runtime_error("layer of map at " + filename + " has a tile id that is out of range");
+		}
+		data[i] = id;
+	}
+	free(inflated);
 }
 
 char* loadTextFile(std::string filename)
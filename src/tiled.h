@@ -7,10 +7,14 @@
 #include <fstream>
 #include <stdexcept>
 #include <stdlib.h>
+#include <climits>
 #include <vector>
+#include <algorithm>
 
 #include <iostream>
 
+#include "jobSystem.h"
+
 namespace tiled
 {
 
@@ -43,11 +47,25 @@ struct MapProperties
 };
 
 static Properties fillPropStruct(rapidxml::xml_node<> *propertiesNode);
+static void parseLayerData(const char* text, size_t size, std::vector<unsigned int> &data, size_t tiles, const std::string &filename);
+static void decodeLayerData(const char* text, size_t size, std::string compression, std::vector<unsigned int> &data, size_t tiles, const std::string &filename);
+
+//part of a layer of an infinite map, in tiles from the map's first chunk
+struct LayerChunk
+{
+	int x = 0;
+	int y = 0;
+	unsigned int width = 0;
+	unsigned int height = 0;
+	std::vector<unsigned int> data;
+};
 
 struct Layer
 {
 	Properties props;
+	//empty for infinite maps, which fill chunks instead
 	std::vector<unsigned int> data;
+	std::vector<LayerChunk> chunks;
 };
 
 struct Object
@@ -75,8 +93,10 @@ struct ImageLayer
 struct Tileset
 {
 	Tileset(std::string filename);
+	Tileset() {}
 
 	unsigned int firstTileID = 0;
+	std::string source;
 
 	std::string name;
 	unsigned int tileWidth;
@@ -100,6 +120,10 @@ public:
 	unsigned int tileWidth;
 	unsigned int tileHeight;
 	unsigned int totalTiles;
+	bool infinite = false;
+	//tile in the tmx that is 0,0 here, objects are moved to match
+	int originX = 0;
+	int originY = 0;
 
 	std::vector<Tileset> tilesets;
 	std::vector<Layer> layers;
@@ -107,6 +131,9 @@ public:
 	std::vector<ImageLayer> imgLayer;
 	
 	MapProperties props;
+
+private:
+	void shiftToChunkBounds();
 };
 
 } //namespace end
@@ -8,19 +8,28 @@ class Timer
 public:
 	Timer()
 	{
-		start = std::chrono::high_resolution_clock::now();
+		start = std::chrono::steady_clock::now();
 		lastUpdate = start;
 		currentUpdate = start;
 	}
 	void Update()
 	{
 		lastUpdate = currentUpdate;
-		currentUpdate = std::chrono::high_resolution_clock::now();
+		currentUpdate = std::chrono::steady_clock::now();
 	}
 
-	long long FrameElapsed()
+	//steps the timer by a set time instead of the clock, for fixed step updates
+	void Advance(double milliseconds)
 	{
-		return std::chrono::duration_cast<std::chrono::milliseconds>(currentUpdate - lastUpdate).count();
+		lastUpdate = currentUpdate;
+		currentUpdate += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			std::chrono::duration<double, std::milli>(milliseconds));
+	}
+
+	//in milliseconds, with sub millisecond precision
+	double FrameElapsed()
+	{
+		return std::chrono::duration<double, std::milli>(currentUpdate - lastUpdate).count();
 	}
 
 private:
@@ -31,4 +40,4 @@ private:
 
 
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,84 @@
+#include "triggers.h"
+
+void TriggerIndex::Add(glm::vec4 rect, TriggerType type, unsigned int data)
+{
+	triggers.push_back({rect, type, data});
+	inside.push_back(0);
+	disabled.push_back(0);
+}
+
+void TriggerIndex::Build(glm::vec4 area)
+{
+	std::vector<glm::vec4> rects(triggers.size());
+	for(unsigned int i = 0; i < triggers.size(); i++)
+		rects[i] = triggers[i].rect;
+	grid = gh::SpatialGrid(area, gh::SPATIAL_GRID_CELL_SIZE, rects);
+	haveCells = false;
+}
+
+glm::vec4 TriggerIndex::Bounds()
+{
+	if(triggers.size() == 0)
+		return glm::vec4(0);
+	glm::vec2 start(triggers[0].rect.x, triggers[0].rect.y);
+	glm::vec2 end = start;
+	for(const auto &trigger: triggers)
+	{
+		start.x = std::min(start.x, trigger.rect.x);
+		start.y = std::min(start.y, trigger.rect.y);
+		end.x = std::max(end.x, trigger.rect.x + trigger.rect.z);
+		end.y = std::max(end.y, trigger.rect.y + trigger.rect.w);
+	}
+	return glm::vec4(start.x, start.y, end.x - start.x, end.y - start.y);
+}
+
+void TriggerIndex::Update(glm::vec4 hitbox, glm::vec4 sprite)
+{
+	events.clear();
+	glm::vec4 bounds;
+	bounds.x = std::min(hitbox.x, sprite.x);
+	bounds.y = std::min(hitbox.y, sprite.y);
+	bounds.z = std::max(hitbox.x + hitbox.z, sprite.x + sprite.z) - bounds.x;
+	bounds.w = std::max(hitbox.y + hitbox.w, sprite.y + sprite.w) - bounds.y;
+	std::array<unsigned int, 4> newCells = grid.Cells(bounds);
+	if(!haveCells || newCells != cells)
+	{
+		grid.QueryStaticIds(bounds, candidates);
+		cells = newCells;
+		haveCells = true;
+	}
+
+	//anything inside but no longer a candidate can't be touching the player
+	for(auto i: insideList)
+		if(!std::binary_search(candidates.begin(), candidates.end(), i))
+		{
+			inside[i] = 0;
+			events.push_back({TriggerEvent::Exit, triggers[i].type, i, triggers[i].data});
+		}
+	insideList.clear();
+	for(auto i: candidates)
+	{
+		if(disabled[i])
+			continue;
+		const Trigger &t = triggers[i];
+		bool touching = gh::colliding(TriggerIndex::OnSprite(t.type) ? sprite : hitbox, t.rect);
+		if(touching)
+		{
+			events.push_back({inside[i] ? TriggerEvent::Stay : TriggerEvent::Enter, t.type, i, t.data});
+			insideList.push_back(i);
+		}
+		else if(inside[i])
+			events.push_back({TriggerEvent::Exit, t.type, i, t.data});
+		inside[i] = touching;
+	}
+	std::sort(events.begin(), events.end(), [](const TriggerHit &a, const TriggerHit &b) {
+		return a.trigger < b.trigger;
+	});
+}
+
+void TriggerIndex::Disable(unsigned int trigger)
+{
+	disabled[trigger] = 1;
+	inside[trigger] = 0;
+	insideList.erase(std::remove(insideList.begin(), insideList.end(), trigger), insideList.end());
+}
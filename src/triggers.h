@@ -0,0 +1,84 @@
+#ifndef TRIGGERS_H
+#define TRIGGERS_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <array>
+#include <algorithm>
+
+#include "gamehelper.h"
+#include "spatialGrid.h"
+
+//manhattan distance from a door's corner to the player's middle that opens it
+const float DOOR_TRIGGER_RANGE = 150;
+
+enum class TriggerType
+{
+	Checkpoint,
+	Item,
+	Message,
+	ReactorRoom,
+	ReactorTP,
+	Door,
+};
+
+enum class TriggerEvent
+{
+	Enter,
+	Stay,
+	Exit,
+};
+
+struct Trigger
+{
+	glm::vec4 rect;
+	TriggerType type;
+	//index into the map's list for that type
+	unsigned int data;
+};
+
+struct TriggerHit
+{
+	TriggerEvent event;
+	TriggerType type;
+	unsigned int trigger;
+	unsigned int data;
+};
+
+//static trigger volumes from the map's object groups, tested against the player each tick.
+//only triggers binned in the player's cells are tested, the candidates are found again when those cells change
+class TriggerIndex
+{
+public:
+	TriggerIndex() {}
+
+	void Add(glm::vec4 rect, TriggerType type, unsigned int data);
+	//bins the triggers added so far, call after adding
+	void Build(glm::vec4 area);
+	//the reactor room is tested against the player's sprite like before, and doors too since their range
+	//is measured from the sprite's middle, everything else against the hitbox
+	void Update(glm::vec4 hitbox, glm::vec4 sprite);
+	static bool OnSprite(TriggerType type) { return type == TriggerType::ReactorRoom || type == TriggerType::Door; }
+	//events from the last update in trigger order, stay is sent every update while inside
+	const std::vector<TriggerHit>& Events() { return events; }
+	//stops a trigger firing again, without an exit event
+	void Disable(unsigned int trigger);
+
+	unsigned int Count() { return (unsigned int)triggers.size(); }
+	//the rect around every trigger added so far
+	glm::vec4 Bounds();
+
+private:
+	std::vector<Trigger> triggers;
+	std::vector<unsigned char> inside;
+	std::vector<unsigned char> disabled;
+	gh::SpatialGrid grid;
+
+	bool haveCells = false;
+	std::array<unsigned int, 4> cells;
+	std::vector<unsigned int> candidates;
+	std::vector<unsigned int> insideList;
+	std::vector<TriggerHit> events;
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef RECT_HELPER_H
+#define RECT_HELPER_H
+
+#ifndef GLM_FORCE_DEPTH_ZERO_TO_ONE
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#endif
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+//quad matrices and texture offsets, only glm so the headless build shares them with the renderer
+struct recthelper
+{
+	static glm::mat4 getModelMatrix(glm::vec4 drawRect, float rotate);
+	static glm::vec4 getTextureOffset(glm::vec4 drawArea, glm::vec4 textureArea);
+	static glm::mat4 calcMatFromRect(glm::vec4 rect, float rotate);
+	static glm::vec4 calcTexOffset(glm::vec2 texDim, glm::vec4 section);
+};
+
+#endif
@@ -158,6 +158,13 @@ Resource::Texture Render::LoadTexture(std::string filepath)
 	return mTextureLoader.loadTexture(filepath);
 }
 
+Resource::Texture Render::LoadTexture(unsigned char* data, int width, int height, int nrChannels)
+{
+	if (mFinishedLoadingResources)
+		throw std::runtime_error("resource loading has finished already");
+	return Resource::Texture(mTextureLoader.loadTexture(data, width, height, nrChannels), glm::vec2(width, height), "NULL");
+}
+
 Resource::Font* Render::LoadFont(std::string filepath)
 {
 	if (mFinishedLoadingResources)
@@ -181,6 +188,12 @@ Resource::Model Render::LoadModel(std::string filepath)
 }
 #endif
 
+unsigned int Render::TexturesLeft()
+{
+	unsigned int loaded = mTextureLoader.count();
+	return loaded < (unsigned int)Resource::MAX_TEXTURES_SUPPORTED ? Resource::MAX_TEXTURES_SUPPORTED - loaded : 0;
+}
+
 void Render::endResourceLoad()
 {
 	mFinishedLoadingResources = true;
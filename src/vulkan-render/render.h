@@ -36,11 +36,14 @@ public:
 	void set2DViewMatrix(glm::mat4 view);
 	~Render();
 	Resource::Texture LoadTexture(std::string filepath);
+	Resource::Texture LoadTexture(unsigned char* data, int width, int height, int nrChannels);
 	Resource::Font* LoadFont(std::string filepath);
 	#ifndef ONLY_2D
 	Resource::Model LoadModel(std::string filepath);
 	#endif
 	void endResourceLoad();
+	//textures that can still be loaded, endResourceLoad throws past MAX_TEXTURES_SUPPORTED
+	unsigned int TexturesLeft();
 #ifndef ONLY_2D
 	void begin3DDraw();
 	#endif
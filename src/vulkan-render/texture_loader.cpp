@@ -26,9 +26,16 @@ Texture TextureLoader::loadTexture(std::string path)
 {
 	texToLoad.push_back({ path });
 	TempTexture* tex = &texToLoad.back();
-	tex->pixelData = stbi_load(tex->path.c_str(), &tex->width, &tex->height, &tex->nrChannels, 0);
-	if (!tex->pixelData)
+	tex->pixelData = nullptr;
+	//only the header is read here, pixels are decoded by a job and waited for in endLoading
+	if (!stbi_info(tex->path.c_str(), &tex->width, &tex->height, &tex->nrChannels))
 		throw std::runtime_error("failed to load texture at " + path);
+	if (!decoding)
+		decoding = std::make_shared<gh::JobCounter>();
+	gh::JobSystem::Get().Run([tex] {
+		int width, height, channels;
+		tex->pixelData = stbi_load(tex->path.c_str(), &width, &height, &channels, 0);
+	}, decoding.get());
 
 	tex->fileSize = tex->width * tex->height * tex->nrChannels;
 
@@ -105,8 +112,13 @@ uint32_t TextureLoader::loadTexture(unsigned char* data, int width, int height,
 
 void TextureLoader::endLoading()
 {
+	if (decoding)
+		gh::JobSystem::Get().Wait(*decoding);
 	if (texToLoad.size() <= 0)
 		return;
+	for (const auto& tex : texToLoad)
+		if (!tex.pixelData)
+			throw std::runtime_error("failed to load texture at " + tex.path);
 
 	if (texToLoad.size() > MAX_TEXTURES_SUPPORTED)
 		throw std::runtime_error("not enough storage for textures");
@@ -143,7 +155,7 @@ void TextureLoader::endLoading()
 		if (texToLoad[i].path != "NULL")
 			stbi_image_free(texToLoad[i].pixelData);
 		else
-			delete texToLoad[i].pixelData;
+			delete[] texToLoad[i].pixelData;
 		texToLoad[i].pixelData = nullptr;
 
 		bufferOffset += texToLoad[i].fileSize;
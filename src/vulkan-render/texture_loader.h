@@ -11,12 +11,15 @@
 #include <stdexcept>
 #include <cmath>
 #include <cstring>
+#include <deque>
+#include <memory>
 
 #include "stb_image.h"
 #include "config.h"
 #include "render_structs.h"
 #include "descriptor_sets.h"
 #include "vkhelper.h"
+#include "../jobSystem.h"
 
 namespace Resource
 {
@@ -91,6 +94,7 @@ public:
 	uint32_t loadTexture(unsigned char* data, int width, int height, int nrChannels);
 	VkImageView getImageView(uint32_t texID);
 	void endLoading();
+	unsigned int count() { return (unsigned int)texToLoad.size(); }
 	void prepareFragmentDescriptorSet(DS::DescriptorSet &textureDS, size_t frameCount);
 
 	VkSampler sampler;
@@ -99,7 +103,9 @@ private:
 	Base base;
 	VkCommandPool pool;
 
-	std::vector<TempTexture> texToLoad;
+	//deque so decode jobs keep valid pointers while more textures are added
+	std::deque<TempTexture> texToLoad;
+	std::shared_ptr<gh::JobCounter> decoding;
 	std::vector<LoadedTexture> textures;
 	VkDeviceMemory memory;
 };
@@ -15,36 +15,6 @@ uint32_t vkhelper::findMemoryIndex(VkPhysicalDevice physicalDevice, uint32_t mem
 	throw std::runtime_error("failed to find suitable memory type");
 }
 
-glm::mat4 vkhelper::getModelMatrix(glm::vec4 drawRect, float rotate)
-{
-	glm::mat4 model = glm::mat4(1.0f);
-
-	model = glm::translate(model, glm::vec3(drawRect.x, drawRect.y, 0.0f)); //translate object by position
-	//rotate object
-	model = glm::translate(model, glm::vec3(0.5 * drawRect.z, 0.5 * drawRect.w, 0.0)); // move object by half its size, so rotates around centre
-	model = glm::rotate(model, glm::radians(rotate), glm::vec3(0.0, 0.0, 1.0));//then do rotation
-	model = glm::translate(model, glm::vec3(-0.5 * drawRect.z, -0.5 * drawRect.w, 0.0)); //then translate back to original position
-
-	model = glm::scale(model, glm::vec3(drawRect.z, drawRect.w, 1.0f)); //then scale
-
-	return model;
-}
-
-glm::vec4 vkhelper::getTextureOffset(glm::vec4 drawArea, glm::vec4 textureArea)
-{
-	if (drawArea.z == textureArea.z && textureArea.x == 0 && textureArea.y == 0)
-		return glm::vec4(0, 0, 1, 1);
-
-	glm::vec4 offset = glm::vec4(0, 0, 1, 1);
-	offset.x = -(textureArea.x) / drawArea.z;
-	offset.y = -(textureArea.y) / drawArea.w;
-	offset.z = drawArea.z / textureArea.z;
-	offset.w = drawArea.w / textureArea.w;
-
-	return offset;
-}
-
-
 void vkhelper::createBufferAndMemory(Base base, VkDeviceSize size, VkBuffer* buffer, VkDeviceMemory* memory,
 	VkBufferUsageFlags usage, VkMemoryPropertyFlags properties)
 {
@@ -75,7 +45,6 @@ void vkhelper::createMemory(VkDevice device, VkPhysicalDevice physicalDevice, Vk
 		throw std::runtime_error("failed to allocate memory of size " + size);
 }
 
-
 void vkhelper::createDescriptorSet(VkDevice device, DS::DescriptorSet &ds, size_t setCount)
 {
 	VkDescriptorPoolCreateInfo poolInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
@@ -151,24 +120,3 @@ void vkhelper::prepareShaderBufferSets(Base base,	std::vector<DS::ShaderBufferSe
 		vkUpdateDescriptorSets(base.device, writes.size(), writes.data(), 0, nullptr);
 	}
 }
-
-glm::mat4 vkhelper::calcMatFromRect(glm::vec4 rect, float rotate)
-{
-		glm::mat4 model = glm::mat4(1.0f);
-		model = glm::mat4(1.0f);
-		model = glm::translate(model, glm::vec3(rect.x, rect.y, 0.0f));
-
-		if(rotate != 0)
-		{
-			model = glm::translate(model, glm::vec3(0.5 * rect.z, 0.5 * rect.w, 0.0));
-			model = glm::rotate(model, glm::radians(rotate), glm::vec3(0.0, 0.0, 1.0));
-			model = glm::translate(model, glm::vec3(-0.5 * rect.z, -0.5 * rect.w, 0.0)); 
-		}
-		model = glm::scale(model, glm::vec3(rect.z, rect.w, 1.0f)); 
-		return model;
-}
-
-glm::vec4 vkhelper::calcTexOffset(glm::vec2 texDim, glm::vec4 section)
-{
-	return glm::vec4(section.x / texDim.x, section.y / texDim.y, section.z / texDim.x, section.w /  texDim.y);
-}
\ No newline at end of file
@@ -16,13 +16,12 @@
 #include "render_structs.h"
 #include "descriptor_sets.h"
 #include "pipeline.h"
+#include "rect_helper.h"
 
-struct vkhelper
+struct vkhelper : public recthelper
 {
 	static uint32_t findMemoryIndex(VkPhysicalDevice physicalDevice, 
 		uint32_t memoryTypeBits, VkMemoryPropertyFlags properties);
-	static glm::mat4 getModelMatrix(glm::vec4 drawRect, float rotate);
-	static glm::vec4 getTextureOffset(glm::vec4 drawArea, glm::vec4 textureArea);
 	static void createBufferAndMemory(Base base, VkDeviceSize size, VkBuffer* buffer, VkDeviceMemory* memory,
 		VkBufferUsageFlags usage, VkMemoryPropertyFlags properties);
 	static void createMemory(VkDevice device, VkPhysicalDevice physicalDevice, VkDeviceSize size, VkDeviceMemory* memory,
@@ -30,9 +29,6 @@ struct vkhelper
 	static void createDescriptorSet(VkDevice device, DS::DescriptorSet &ds, size_t setCount);
 	static void prepareShaderBufferSets(Base base,	std::vector<DS::ShaderBufferSet*> ds,
 		VkBuffer* buffer, VkDeviceMemory* memory);
-
-	static glm::mat4 calcMatFromRect(glm::vec4 rect, float rotate);
-	static glm::vec4 calcTexOffset(glm::vec2 texDim, glm::vec4 section);
 };
 
 
@@ -0,0 +1,30 @@
+//compiles Tiled maps into the binary maps Map loads instead of parsing the tmx, run from the resources folder.
+//the game only reads these, without one a map is parsed each load and an infinite map can't be loaded
+#include <iostream>
+#include <string>
+
+#include "map.h"
+
+int main(int argc, char** argv)
+{
+	if(argc < 2)
+	{
+		std::cerr << "usage: " << argv[0] << " <map.tmx>..." << std::endl;
+		return EXIT_FAILURE;
+	}
+	try
+	{
+		for(int i = 1; i < argc; i++)
+		{
+			if(!Map::Compile(argv[i]))
+				return EXIT_FAILURE;
+			std::cout << argv[i] << " -> " << Map::CompiledPath(argv[i]) << std::endl;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
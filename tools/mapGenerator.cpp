@@ -0,0 +1,389 @@
+//writes Tiled maps of any size for scaling benchmarks, built from the forgotten lab tilesets.
+//the map is a grid of rooms joined by doorways, with floor, wall and decoration layers,
+//solid and gap tile layers, and object groups laid out like the shipped maps.
+//infinite maps are written as chunks like Tiled does, centred on tile 0,0
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include <cstdlib>
+
+const unsigned int TILE_SIZE = 32;
+//rooms include their wall ring
+const unsigned int ROOM_WIDTH = 24;
+const unsigned int ROOM_HEIGHT = 18;
+const unsigned int DOORWAY_SIZE = 3;
+//first ids of the tilesets, in the order they are written
+const unsigned int FLOOR_FIRST = 1;
+const unsigned int FLOOR_COUNT = 20;
+const unsigned int WALL_FIRST = 21;
+const unsigned int WALL_COUNT = 30;
+const unsigned int ITEM_FIRST = 51;
+const float DECOR_DENSITY = 0.03f;
+
+struct Options
+{
+	unsigned int width = 1000;
+	unsigned int height = 1000;
+	//drawn tile layers, the first is floor, the second walls, the rest decoration
+	unsigned int layers = 3;
+	//chance a tile inside a room is solid, gaps are a quarter of this
+	float colliderDensity = 0.05f;
+	unsigned int objects = 1000;
+	unsigned int seed = 1;
+	//chunk size of an infinite map, 0 for a fixed size map
+	unsigned int chunkSize = 0;
+	std::string out = "generated.tmx";
+};
+
+struct Rect
+{
+	unsigned int x, y, w, h;
+};
+
+class Generator
+{
+public:
+	Generator(Options options) : options(options), random(options.seed)
+	{
+		roomsX = std::max(1u, options.width / ROOM_WIDTH);
+		roomsY = std::max(1u, options.height / ROOM_HEIGHT);
+		if(options.chunkSize > 0)
+		{
+			shiftX = -(int)(options.width / 2 / options.chunkSize * options.chunkSize);
+			shiftY = -(int)(options.height / 2 / options.chunkSize * options.chunkSize);
+		}
+	}
+
+	void Write()
+	{
+		std::ofstream file(options.out);
+		if(!file)
+			throw std::runtime_error("failed to open " + options.out + " for writing");
+		nextID = 1;
+		nextLayerID = 1;
+		std::vector<Rect> walls;
+		wallRects(walls);
+		unsigned int objectCount = walls.size() + roomsX * roomsY + 1 + options.objects;
+		file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+			<< "<map version=\"1.5\" tiledversion=\"1.7.2\" orientation=\"orthogonal\" renderorder=\"right-down\" width=\""
+			<< options.width << "\" height=\"" << options.height << "\" tilewidth=\"" << TILE_SIZE << "\" tileheight=\""
+			<< TILE_SIZE << "\" infinite=\"" << (options.chunkSize > 0 ? 1 : 0) << "\" nextlayerid=\"" << options.layers + 2 + 7 + 1
+			<< "\" nextobjectid=\"" << objectCount + 1 << "\">\n"
+			<< " <properties>\n  <property name=\"music\" value=\"audio/music/FalloutMusic2.mp3\"/>\n </properties>\n"
+			<< " <tileset firstgid=\"" << FLOOR_FIRST << "\" source=\"Forgotten.tsx\"/>\n"
+			<< " <tileset firstgid=\"" << WALL_FIRST << "\" source=\"forgottenWall.tsx\"/>\n"
+			<< " <tileset firstgid=\"" << ITEM_FIRST << "\" source=\"items.tsx\"/>\n";
+
+		std::uniform_real_distribution<float> chance(0, 1);
+		std::uniform_int_distribution<unsigned int> floorTile(FLOOR_FIRST, FLOOR_FIRST + FLOOR_COUNT - 1);
+		std::uniform_int_distribution<unsigned int> wallTile(WALL_FIRST, WALL_FIRST + WALL_COUNT - 1);
+		std::vector<unsigned int> data(options.width * options.height);
+		for(unsigned int l = 0; l < options.layers; l++)
+		{
+			for(unsigned int y = 0; y < options.height; y++)
+				for(unsigned int x = 0; x < options.width; x++)
+				{
+					unsigned int tile = 0;
+					if(l == 0)
+						tile = inRoom(x, y) && !wall(x, y) ? floorTile(random) : 0;
+					else if(l == 1)
+						tile = wall(x, y) ? wallTile(random) : 0;
+					else if(inRoom(x, y) && !wall(x, y) && chance(random) < DECOR_DENSITY)
+						tile = floorTile(random);
+					data[y * options.width + x] = tile;
+				}
+			writeLayer(file, l == 0 ? "bg" : l == 1 ? "bgWall" : "decor" + std::to_string(l - 1), "", data);
+		}
+		//kept off the doorway rows and columns so every room stays reachable
+		for(int pass = 0; pass < 2; pass++)
+		{
+			float density = pass == 0 ? options.colliderDensity : options.colliderDensity / 4;
+			for(unsigned int y = 0; y < options.height; y++)
+				for(unsigned int x = 0; x < options.width; x++)
+					data[y * options.width + x] = inRoom(x, y) && !wall(x, y) && !nearDoorway(x, y)
+						&& chance(random) < density ? floorTile(random) : 0;
+			writeLayer(file, pass == 0 ? "solid" : "gaps", pass == 0 ? "collidable" : "gap", data);
+		}
+
+		file << objectGroup("colliders") << boolProperties("collidable", 2);
+		for(const auto &r: walls)
+			writeRect(file, r, "");
+		file << " </objectgroup>\n";
+
+		file << objectGroup("cameraLayer") << boolProperties("camera", 2);
+		for(unsigned int ry = 0; ry < roomsY; ry++)
+			for(unsigned int rx = 0; rx < roomsX; rx++)
+				writeRect(file, {rx * ROOM_WIDTH * TILE_SIZE, ry * ROOM_HEIGHT * TILE_SIZE,
+								ROOM_WIDTH * TILE_SIZE, ROOM_HEIGHT * TILE_SIZE}, "");
+		file << " </objectgroup>\n";
+
+		file << objectGroup("playerMisc");
+		writePoint(file, (ROOM_WIDTH / 2) * TILE_SIZE, (ROOM_HEIGHT / 2) * TILE_SIZE, boolProperties("playerSpawn", 3));
+		file << " </objectgroup>\n";
+
+		//half enemies, a quarter lights, the rest scientists and checkpoints
+		unsigned int enemies = options.objects / 2;
+		unsigned int lights = options.objects / 4;
+		unsigned int scientists = (options.objects - enemies - lights) * 3 / 5;
+		unsigned int checkpoints = options.objects - enemies - lights - scientists;
+		file << objectGroup("enemySpawns") << boolProperties("enemySpawn", 2);
+		for(unsigned int i = 0; i < enemies; i++)
+			writeFloorPoint(file, "");
+		file << " </objectgroup>\n";
+		file << objectGroup("lights") << boolProperties("light", 2);
+		for(unsigned int i = 0; i < lights; i++)
+			writeFloorPoint(file, "");
+		file << " </objectgroup>\n";
+		file << objectGroup("scientists") << boolProperties("scientistSpawn", 2);
+		for(unsigned int i = 0; i < scientists; i++)
+			writeFloorPoint(file, "");
+		file << " </objectgroup>\n";
+		file << objectGroup("checkpoint") << boolProperties("checkpoint", 2);
+		for(unsigned int i = 0; i < checkpoints; i++)
+		{
+			unsigned int x, y;
+			floorSpot(x, y);
+			writeRect(file, {x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE * 3, TILE_SIZE}, "");
+		}
+		file << " </objectgroup>\n</map>\n";
+		if(!file)
+			throw std::runtime_error("failed to write " + options.out);
+
+		std::cout << "wrote " << options.out << ": " << options.width << "x" << options.height << " tiles, "
+			<< options.layers << " drawn layers, " << roomsX * roomsY << " rooms, " << walls.size() << " wall colliders, "
+			<< options.objects << " objects" << std::endl;
+	}
+
+private:
+	bool inRoom(unsigned int x, unsigned int y)
+	{
+		return x < roomsX * ROOM_WIDTH && y < roomsY * ROOM_HEIGHT;
+	}
+
+	//every room's top and left edge is a wall with a doorway in the middle, plus the far edges of the map
+	bool wall(unsigned int x, unsigned int y)
+	{
+		if(!inRoom(x, y))
+			return false;
+		if(x == roomsX * ROOM_WIDTH - 1 || y == roomsY * ROOM_HEIGHT - 1)
+			return true;
+		unsigned int lx = x % ROOM_WIDTH;
+		unsigned int ly = y % ROOM_HEIGHT;
+		bool top = ly == 0 && !(y > 0 && doorway(lx, ROOM_WIDTH));
+		bool left = lx == 0 && !(x > 0 && doorway(ly, ROOM_HEIGHT));
+		return top || left;
+	}
+
+	bool doorway(unsigned int along, unsigned int size)
+	{
+		return along >= (size - DOORWAY_SIZE) / 2 && along < (size + DOORWAY_SIZE) / 2;
+	}
+
+	bool nearDoorway(unsigned int x, unsigned int y)
+	{
+		unsigned int lx = x % ROOM_WIDTH;
+		unsigned int ly = y % ROOM_HEIGHT;
+		return (lx + 1 >= (ROOM_WIDTH - DOORWAY_SIZE) / 2 && lx <= (ROOM_WIDTH + DOORWAY_SIZE) / 2)
+			|| (ly + 1 >= (ROOM_HEIGHT - DOORWAY_SIZE) / 2 && ly <= (ROOM_HEIGHT + DOORWAY_SIZE) / 2);
+	}
+
+	//one rect per run of wall tiles along each wall row and column
+	void wallRects(std::vector<Rect> &rects)
+	{
+		for(unsigned int y = 0; y < roomsY * ROOM_HEIGHT; y++)
+		{
+			if(y % ROOM_HEIGHT != 0 && y != roomsY * ROOM_HEIGHT - 1)
+				continue;
+			for(unsigned int x = 0; x < roomsX * ROOM_WIDTH; x++)
+			{
+				if(!wall(x, y))
+					continue;
+				unsigned int start = x;
+				while(x < roomsX * ROOM_WIDTH && wall(x, y))
+					x++;
+				rects.push_back({start * TILE_SIZE, y * TILE_SIZE, (x - start) * TILE_SIZE, TILE_SIZE});
+			}
+		}
+		for(unsigned int x = 0; x < roomsX * ROOM_WIDTH; x++)
+		{
+			if(x % ROOM_WIDTH != 0 && x != roomsX * ROOM_WIDTH - 1)
+				continue;
+			for(unsigned int y = 0; y < roomsY * ROOM_HEIGHT; y++)
+			{
+				//corners are already covered by the row rects
+				if(!wall(x, y) || y % ROOM_HEIGHT == 0 || y == roomsY * ROOM_HEIGHT - 1)
+					continue;
+				unsigned int start = y;
+				while(y < roomsY * ROOM_HEIGHT && wall(x, y) && y % ROOM_HEIGHT != 0)
+					y++;
+				rects.push_back({x * TILE_SIZE, start * TILE_SIZE, TILE_SIZE, (y - start) * TILE_SIZE});
+				y--;
+			}
+		}
+	}
+
+	void floorSpot(unsigned int &x, unsigned int &y)
+	{
+		std::uniform_int_distribution<unsigned int> rx(0, roomsX * ROOM_WIDTH - 1);
+		std::uniform_int_distribution<unsigned int> ry(0, roomsY * ROOM_HEIGHT - 1);
+		do
+		{
+			x = rx(random);
+			y = ry(random);
+		} while(wall(x, y));
+	}
+
+	void writeFloorPoint(std::ofstream &file, std::string properties)
+	{
+		unsigned int x, y;
+		floorSpot(x, y);
+		writePoint(file, x * TILE_SIZE + TILE_SIZE / 2, y * TILE_SIZE + TILE_SIZE / 2, properties);
+	}
+
+	void writeLayer(std::ofstream &file, std::string name, std::string property, const std::vector<unsigned int> &data)
+	{
+		file << " <layer id=\"" << nextLayerID++ << "\" name=\"" << name << "\" width=\"" << options.width << "\" height=\"" << options.height << "\">\n";
+		if(property != "")
+			file << boolProperties(property, 2);
+		file << "  <data encoding=\"csv\">\n";
+		if(options.chunkSize > 0)
+		{
+			writeChunks(file, data);
+			file << "  </data>\n </layer>\n";
+			return;
+		}
+		std::string row;
+		for(unsigned int y = 0; y < options.height; y++)
+		{
+			row.clear();
+			for(unsigned int x = 0; x < options.width; x++)
+			{
+				row += std::to_string(data[y * options.width + x]);
+				if(x + 1 < options.width || y + 1 < options.height)
+					row += ',';
+			}
+			file << row << '\n';
+		}
+		file << "</data>\n </layer>\n";
+	}
+
+	//chunks with no tiles are left out, like Tiled does
+	void writeChunks(std::ofstream &file, const std::vector<unsigned int> &data)
+	{
+		unsigned int size = options.chunkSize;
+		std::string text;
+		for(unsigned int cy = 0; cy < options.height; cy += size)
+			for(unsigned int cx = 0; cx < options.width; cx += size)
+			{
+				text.clear();
+				bool empty = true;
+				for(unsigned int y = cy; y < cy + size; y++)
+				{
+					text += '\n';
+					for(unsigned int x = cx; x < cx + size; x++)
+					{
+						unsigned int tile = x < options.width && y < options.height ? data[y * options.width + x] : 0;
+						empty = empty && tile == 0;
+						text += std::to_string(tile);
+						if(x + 1 < cx + size || y + 1 < cy + size)
+							text += ',';
+					}
+				}
+				if(empty)
+					continue;
+				file << "   <chunk x=\"" << (int)cx + shiftX << "\" y=\"" << (int)cy + shiftY << "\" width=\"" << size
+					<< "\" height=\"" << size << "\">" << text << "\n</chunk>\n";
+			}
+	}
+
+	void writeRect(std::ofstream &file, Rect r, std::string properties)
+	{
+		file << "  <object id=\"" << nextID++ << "\" x=\"" << (int)r.x + shiftX * (int)TILE_SIZE
+			<< "\" y=\"" << (int)r.y + shiftY * (int)TILE_SIZE
+			<< "\" width=\"" << r.w << "\" height=\"" << r.h << "\"";
+		if(properties == "")
+			file << "/>\n";
+		else
+			file << ">\n" << properties << "  </object>\n";
+	}
+
+	void writePoint(std::ofstream &file, unsigned int x, unsigned int y, std::string properties)
+	{
+		file << "  <object id=\"" << nextID++ << "\" x=\"" << (int)x + shiftX * (int)TILE_SIZE
+			<< "\" y=\"" << (int)y + shiftY * (int)TILE_SIZE << "\">\n"
+			<< properties << "   <point/>\n  </object>\n";
+	}
+
+	std::string objectGroup(std::string name)
+	{
+		return " <objectgroup id=\"" + std::to_string(nextLayerID++) + "\" name=\"" + name + "\">\n";
+	}
+
+	std::string boolProperties(std::string name, unsigned int indent)
+	{
+		std::string pad(indent, ' ');
+		return pad + "<properties>\n" + pad + " <property name=\"" + name
+			+ "\" type=\"bool\" value=\"true\"/>\n" + pad + "</properties>\n";
+	}
+
+	Options options;
+	std::mt19937 random;
+	unsigned int roomsX, roomsY;
+	//tiles everything is moved by, so an infinite map has chunks on both sides of 0
+	int shiftX = 0;
+	int shiftY = 0;
+	unsigned int nextID = 1;
+	unsigned int nextLayerID = 1;
+};
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		Options options;
+		std::string usage = "usage: " + std::string(argv[0]) + " [--size <width>x<height>] [--layers <count>]"
+			" [--colliders <0-1>] [--objects <count>] [--seed <seed>] [--infinite <chunk size>] [--out <file.tmx>]";
+		for(int i = 1; i < argc; i += 2)
+		{
+			std::string arg = argv[i];
+			if(i + 1 >= argc)
+				throw std::runtime_error(usage);
+			std::string value = argv[i + 1];
+			if(arg == "--size")
+			{
+				size_t x = value.find('x');
+				if(x == std::string::npos)
+					throw std::runtime_error(usage);
+				options.width = std::stoul(value.substr(0, x));
+				options.height = std::stoul(value.substr(x + 1));
+			}
+			else if(arg == "--layers")
+				options.layers = std::stoul(value);
+			else if(arg == "--colliders")
+				options.colliderDensity = std::stof(value);
+			else if(arg == "--objects")
+				options.objects = std::stoul(value);
+			else if(arg == "--seed")
+				options.seed = std::stoul(value);
+			else if(arg == "--infinite")
+				options.chunkSize = std::stoul(value);
+			else if(arg == "--out")
+				options.out = value;
+			else
+				throw std::runtime_error(usage);
+		}
+		if(options.width < ROOM_WIDTH || options.height < ROOM_HEIGHT || options.layers < 2)
+			throw std::runtime_error("maps need at least one room and two layers");
+		Generator(options).Write();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}